@@ -98,11 +98,15 @@
 #include "scenarios/SWE_Scenario.hh"
 #include "types/Boundary.hh"
 #include "Constants.hh"
+#include "tools/BathymetryCache.hh"
+#include "tools/Float2DNative.hh"
+#include "tools/RestartFile.hh"
 #include <cassert>
 #include <cstring>
 #include <cmath>
 #include <limits>
 #include <algorithm>
+#include <vector>
 
 template <typename T>
 class SWE_Block {
@@ -125,8 +129,21 @@ class SWE_Block {
 
 		// Default methods
 		virtual void initScenario(SWE_Scenario &scenario, BoundaryType boundaries[]);
+		void initScenario(SWE_Scenario &scenario, BoundaryType boundaries[],
+				const BathymetryCache &cache, int cacheOffsetX, int cacheOffsetY);
+		void storeBathymetry(SWE_Scenario &scenario, BathymetryCache &cache, int cacheOffsetX, int cacheOffsetY);
+		bool updateDisplacement(SWE_Scenario &scenario, float time);
+		bool writeRestart(RestartFile &file, RestartFile::Header header);
+		bool readRestart(const RestartFile &file, BoundaryType boundaries[], RestartFile::Header &o_header);
 		virtual void computeMaxTimestep(const float dryTol = defaultDryTol, const float cflNumber = defaultCflNumber);
 
+		// In-situ products, accumulated while updating the unknowns
+		void enableEnvelope(float arrivalThreshold = .01f, float startTime = 0);
+		bool hasEnvelope() const;
+		const Float2DNative& getMaxWaveHeight();
+		const Float2DNative& getMaxSpeed();
+		const Float2DNative& getArrivalTime();
+
 	protected:
 		// Constructor/Destructor
 		SWE_Block<T>();
@@ -138,6 +155,9 @@ class SWE_Block {
 		virtual void applyBoundaryBathymetry();
 		virtual void applyBoundaryConditions();
 
+		// Updates the in-situ products of one cell, called by updateUnknowns()
+		void accumulateEnvelope(int x, int y, float time);
+
 		// Interface methods without a default implementation
 		virtual void setGhostLayer() = 0;
 		virtual void computeNumericalFluxes() = 0;
@@ -168,6 +188,18 @@ class SWE_Block {
 
 		// Boundary type at the block edges (uses Boundary as index)
 		BoundaryType boundaryType[4];
+
+		// Simulation time of the displacement contained in b
+		float displacementTime;
+
+		// In-situ products (allocated by enableEnvelope())
+		bool envelope;
+		float envelopeTime;			///< simulation time of the last update (sum of all time steps)
+		float arrivalThreshold;		///< change of the surface elevation marking the arrival of the wave
+		Float2DNative maxWaveHeight;	///< maximum surface elevation h + b
+		Float2DNative maxSpeed;			///< maximum particle speed in wet cells
+		Float2DNative arrivalTime;		///< first time the surface elevation changed, -1 = not yet
+		Float2DNative initialElevation;	///< surface elevation when the products were enabled
 };
 
 /***************************
@@ -183,7 +215,11 @@ class SWE_Block {
  * -> plus ghost cell layer
  */
 template <typename T>
-SWE_Block<T>::SWE_Block() {
+SWE_Block<T>::SWE_Block() :
+		displacementTime(0),
+		envelope(false),
+		envelopeTime(0),
+		arrivalThreshold(0) {
 }
 
 template <typename T>
@@ -197,7 +233,11 @@ SWE_Block<T>::SWE_Block(int nx, int ny, float dx, float dy, float originX, float
 		h(nx + 2, ny + 2),
 		hu(nx + 2, ny + 2),
 		hv(nx + 2, ny + 2),
-		b(nx + 2, ny + 2) {
+		b(nx + 2, ny + 2),
+		displacementTime(0),
+		envelope(false),
+		envelopeTime(0),
+		arrivalThreshold(0) {
 	// initialise boundaries
 	for (int i = 0; i < 4; i++) {
 		boundaryType[i] = PASSIVE;
@@ -276,27 +316,58 @@ void SWE_Block<T>::setBoundaryType(Boundary boundary, BoundaryType type) {
  */
 template <typename T>
 void SWE_Block<T>::initScenario(SWE_Scenario &scenario, BoundaryType boundaries[]) {
-	float x = 0;
-	float y = 0;
-	for (int i = 1; i < ny + 1; i++) {
-		for (int j = 1; j < nx + 1; j++) {
-			/*
-			 * Map the indices to actual points, shift by one because the ghost layer
-			 * is inserted at indices [0][*], [*][0], [nx + 1][*], [*][ny + 1].
-			 * Therefore, index [1][1], not [0][0], has to map to (originX, originY).
-			 *
-			 * Offset by 1/2 to query the value at the center of the current cell
-			 *
-			 * I.e.: If the origin is at 0,0 and the cell width is 1,
-			 * array index [1][1] will map to the values at 0.5,0.5 ,
-			 * array index [2][2] will map to 1.5,1.5 and so forth.
-			 */
-			x = (float) originX + (j - 0.5) * dx;
-			y = (float) originY + (i - 0.5) * dy;
-			b[j][i] = scenario.getBathymetry(x, y);
-			h[j][i] = scenario.getWaterHeight(x, y);
-			hu[j][i] = scenario.getVeloc_u(x, y) * h[j][i];
-			hv[j][i] = scenario.getVeloc_v(x, y) * h[j][i];
+	/*
+	 * Map the indices to actual points, shift by one because the ghost layer
+	 * is inserted at indices [0][*], [*][0], [nx + 1][*], [*][ny + 1].
+	 * Therefore, index [1][1], not [0][0], has to map to (originX, originY).
+	 *
+	 * Offset by 1/2 to query the value at the center of the current cell
+	 *
+	 * I.e.: If the origin is at 0,0 and the cell width is 1,
+	 * array index [1][1] will map to the values at 0.5,0.5 ,
+	 * array index [2][2] will map to 1.5,1.5 and so forth.
+	 *
+	 * The interior of a column is contiguous, the scenario fills it in one call.
+	 */
+#pragma omp parallel for schedule(dynamic)
+	for (int j = 1; j < nx + 1; j++) {
+		const float x = (float) originX + (j - 0.5) * dx;
+		scenario.getColumn(x, originY, dx, dy, ny, &b[j][1], &h[j][1], &hu[j][1], &hv[j][1]);
+	}
+
+	for (int i = 0; i < 4; i++) {
+		boundaryType[i] = boundaries[i];
+	}
+
+	applyBoundaryConditions();
+	applyBoundaryBathymetry();
+}
+
+/**
+ * Initializes the block like initScenario(), but takes the bathymetry from a
+ * cache instead of sampling it.
+ *
+ * Only the displacement is queried from the scenario. The water has to be at
+ * rest with the surface at zero, i.e. h = max(0, -b) without the displacement.
+ *
+ * @param cache cache of the whole grid, containing the bathymetry without displacement.
+ * @param cacheOffsetX first cell of this block in the cache in x-direction.
+ * @param cacheOffsetY first cell of this block in the cache in y-direction.
+ */
+template <typename T>
+void SWE_Block<T>::initScenario(SWE_Scenario &scenario, BoundaryType boundaries[],
+		const BathymetryCache &cache, int cacheOffsetX, int cacheOffsetY) {
+#pragma omp parallel for schedule(dynamic)
+	for (int j = 1; j < nx + 1; j++) {
+		const float x = (float) originX + (j - 0.5) * dx;
+		cache.readColumn(cacheOffsetX + j - 1, cacheOffsetY, ny, &b[j][1]);
+
+		for (int i = 1; i < ny + 1; i++) {
+			const float y = (float) originY + (i - 0.5) * dy;
+			h[j][i] = (b[j][i] > 0.f) ? 0.f : -b[j][i];
+			hu[j][i] = 0.f;
+			hv[j][i] = 0.f;
+			b[j][i] += scenario.getDisplacement(x, y);
 		}
 	}
 
@@ -308,6 +379,124 @@ void SWE_Block<T>::initScenario(SWE_Scenario &scenario, BoundaryType boundaries[
 	applyBoundaryBathymetry();
 }
 
+/**
+ * Stores the bathymetry of this block (without the displacement) in a cache,
+ * which can be used by initScenario() in later runs.
+ *
+ * @param scenario the scenario used to initialize this block.
+ */
+template <typename T>
+void SWE_Block<T>::storeBathymetry(SWE_Scenario &scenario, BathymetryCache &cache, int cacheOffsetX, int cacheOffsetY) {
+	std::vector<float> column(ny);
+	for (int j = 1; j < nx + 1; j++) {
+		const float x = (float) originX + (j - 0.5) * dx;
+		for (int i = 1; i < ny + 1; i++) {
+			const float y = (float) originY + (i - 0.5) * dy;
+			column[i - 1] = b[j][i] - scenario.getDisplacement(x, y);
+		}
+		cache.writeColumn(cacheOffsetX + j - 1, cacheOffsetY, ny, column.data());
+	}
+}
+
+/**
+ * Applies the change of a time-dependent displacement since the last update to the bathymetry.
+ *
+ * Only the cells in the region reported by the scenario are updated. The water
+ * height is kept, i.e. the surface is lifted together with the sea floor.
+ *
+ * @param scenario scenario providing the dynamic displacement.
+ * @param time current simulation time.
+ * @return true if the displacement changed anywhere in the domain. Since all blocks
+ *         get the same result, they can exchange the bathymetry of CONNECT boundaries
+ *         only in this case.
+ */
+template <typename T>
+bool SWE_Block<T>::updateDisplacement(SWE_Scenario &scenario, float time) {
+	float region[4];
+	if (!scenario.getDisplacementChange(displacementTime, time, region))
+		return false;
+
+	const float previousTime = displacementTime;
+	displacementTime = time;
+
+	// Cells with their center in the region
+	const int firstX = std::max(1, (int) std::ceil((region[0] - originX) / dx + .5f));
+	const int lastX = std::min(nx, (int) std::floor((region[1] - originX) / dx + .5f));
+	const int firstY = std::max(1, (int) std::ceil((region[2] - originY) / dy + .5f));
+	const int lastY = std::min(ny, (int) std::floor((region[3] - originY) / dy + .5f));
+	if (firstX > lastX || firstY > lastY)
+		return true;
+
+#pragma omp parallel for schedule(dynamic)
+	for (int j = firstX; j <= lastX; j++) {
+		const float x = (float) originX + (j - 0.5) * dx;
+		for (int i = firstY; i <= lastY; i++) {
+			const float y = (float) originY + (i - 0.5) * dy;
+			b[j][i] += scenario.getDynamicDisplacement(x, y, time)
+					- scenario.getDynamicDisplacement(x, y, previousTime);
+		}
+	}
+
+	applyBoundaryBathymetry();
+	return true;
+}
+
+/**
+ * Writes the unknowns and the bathymetry of this block to a restart file
+ * (or to an increment of it).
+ *
+ * @param header position of the block and progress of the simulation,
+ *        the grid of the block is filled in.
+ * @return false if the file could not be written
+ */
+template <typename T>
+bool SWE_Block<T>::writeRestart(RestartFile &file, RestartFile::Header header) {
+	header.nX = nx;
+	header.nY = ny;
+	header.originX = originX;
+	header.originY = originY;
+	header.dX = dx;
+	header.dY = dy;
+
+	const float* const fields[RestartFile::fieldCount] = {
+		b.getRawPointer(), h.getRawPointer(), hu.getRawPointer(), hv.getRawPointer()
+	};
+	return file.write(header, fields);
+}
+
+/**
+ * Restores the unknowns and the bathymetry of this block from a restart file
+ * and its increments, replaces initScenario() when a simulation is resumed.
+ *
+ * @param boundaries boundary types of the block.
+ * @param o_header position of the block and progress of the simulation stored in the file.
+ * @return false if the file could not be read or belongs to another grid
+ */
+template <typename T>
+bool SWE_Block<T>::readRestart(const RestartFile &file, BoundaryType boundaries[], RestartFile::Header &o_header) {
+	float* const fields[RestartFile::fieldCount] = {
+		b.getRawPointer(), h.getRawPointer(), hu.getRawPointer(), hv.getRawPointer()
+	};
+	if (!file.read(nx, ny, o_header, fields))
+		return false;
+	if (o_header.originX != originX || o_header.originY != originY
+			|| o_header.dX != dx || o_header.dY != dy) {
+		std::cerr << file.getFileName() << " belongs to another grid" << std::endl;
+		return false;
+	}
+
+	// b already contains the displacement at the time of the restart
+	displacementTime = o_header.time;
+
+	for (int i = 0; i < 4; i++) {
+		boundaryType[i] = boundaries[i];
+	}
+
+	applyBoundaryConditions();
+	applyBoundaryBathymetry();
+	return true;
+}
+
 /**
  * Compute the largest allowed time step for the current grid block
  * (reference implementation) depending on the current values of
@@ -343,6 +532,75 @@ void SWE_Block<T>::computeMaxTimestep( const float dryTol, const float cflNumber
 	maxTimestep *= cflNumber;
 }
 
+/**
+ * Starts accumulating the maximum wave height, the maximum speed and the
+ * arrival time of the wave in every cell. The products are updated in the
+ * same pass as the unknowns, the current state is the reference for the arrival.
+ *
+ * @param i_arrivalThreshold change of the surface elevation (in m) marking the arrival.
+ * @param i_startTime current simulation time, e.g. the time of a restart.
+ */
+template <typename T>
+void SWE_Block<T>::enableEnvelope(float i_arrivalThreshold, float i_startTime) {
+	maxWaveHeight = Float2DNative(nx + 2, ny + 2);
+	maxSpeed = Float2DNative(nx + 2, ny + 2);
+	arrivalTime = Float2DNative(nx + 2, ny + 2);
+	initialElevation = Float2DNative(nx + 2, ny + 2);
+
+	for(int i = 0; i < nx + 2; i++) {
+		for(int j = 0; j < ny + 2; j++) {
+			initialElevation[i][j] = maxWaveHeight[i][j] = h[i][j] + b[i][j];
+			maxSpeed[i][j] = 0;
+			arrivalTime[i][j] = -1;
+		}
+	}
+
+	envelope = true;
+	envelopeTime = i_startTime;
+	arrivalThreshold = i_arrivalThreshold;
+}
+
+template <typename T>
+bool SWE_Block<T>::hasEnvelope() const {
+	return envelope;
+}
+
+template <typename T>
+const Float2DNative& SWE_Block<T>::getMaxWaveHeight() {
+	return maxWaveHeight;
+}
+
+template <typename T>
+const Float2DNative& SWE_Block<T>::getMaxSpeed() {
+	return maxSpeed;
+}
+
+template <typename T>
+const Float2DNative& SWE_Block<T>::getArrivalTime() {
+	return arrivalTime;
+}
+
+/**
+ * Updates the in-situ products of a cell with its new unknowns.
+ *
+ * @param x x-index of the cell.
+ * @param y y-index of the cell.
+ * @param time simulation time after the update.
+ */
+template <typename T>
+inline void SWE_Block<T>::accumulateEnvelope(int x, int y, float time) {
+	const float elevation = h[x][y] + b[x][y];
+	maxWaveHeight[x][y] = std::max(maxWaveHeight[x][y], elevation);
+
+	if (h[x][y] > defaultDryTol) {
+		const float speed = std::sqrt(hu[x][y] * hu[x][y] + hv[x][y] * hv[x][y]) / h[x][y];
+		maxSpeed[x][y] = std::max(maxSpeed[x][y], speed);
+	}
+
+	if (arrivalTime[x][y] < 0 && std::abs(elevation - initialElevation[x][y]) > arrivalThreshold)
+		arrivalTime[x][y] = time;
+}
+
 /**
  * Sets the bathymetry on OUTFLOW or WALL boundaries.
  * Should be called every time a boundary is changed to a OUTFLOW or
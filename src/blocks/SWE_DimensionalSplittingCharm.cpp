@@ -2,10 +2,17 @@
 
 #include "examples/swe_charm.decl.h"
 
-SWE_DimensionalSplittingCharm::SWE_DimensionalSplittingCharm(CkMigrateMessage *msg) {}
+SWE_DimensionalSplittingCharm::SWE_DimensionalSplittingCharm(CkMigrateMessage *msg) {
+	for (int i = 0; i < 4; i++) {
+		recycledCopyLayer[i] = NULL;
+	}
+#ifdef DYNAMIC_DISPLACEMENTS
+	scenario = NULL;
+#endif
+}
 
 SWE_DimensionalSplittingCharm::SWE_DimensionalSplittingCharm(int nx, int ny, float dx, float dy, float originX, float originY, int posX, int posY,
-							BoundaryType boundaries[], std::string outputFilename, std::string bathymetryFilename, std::string displacementFilename) :
+							BoundaryType boundaries[], std::string bathymetryFilename, std::string displacementFilename) :
 		/*
 		 * Important note concerning grid allocations:
 		 * Since index shifts all over the place are bug-prone and maintenance unfriendly,
@@ -37,10 +44,20 @@ SWE_DimensionalSplittingCharm::SWE_DimensionalSplittingCharm(int nx, int ny, flo
 		hNetUpdatesAbove(nx + 1, ny + 2),
 
 		hvNetUpdatesBelow(nx + 1, ny + 2),
-		hvNetUpdatesAbove(nx + 1, ny + 2) {
+		hvNetUpdatesAbove(nx + 1, ny + 2),
+
+		// Rollback copies are only needed if windows span multiple iterations
+		windowH((timestepWindow > 1) ? nx + 2 : 0, (timestepWindow > 1) ? ny + 2 : 0),
+		windowHu((timestepWindow > 1) ? nx + 2 : 0, (timestepWindow > 1) ? ny + 2 : 0),
+		windowHv((timestepWindow > 1) ? nx + 2 : 0, (timestepWindow > 1) ? ny + 2 : 0) {
 
 	currentSimulationTime = 0.;
 	currentCheckpoint = 0;
+	iteration = 0;
+
+	// There is no time step estimate yet, the first window is synchronized
+	recoverWindow = true;
+	windowTimestep = 0.;
 
 	computeTime = 0.;
 	wallTime = 0.;
@@ -60,19 +77,33 @@ SWE_DimensionalSplittingCharm::SWE_DimensionalSplittingCharm(int nx, int ny, flo
 		checkpointInstantOfTime[i] = checkpointInstantOfTime[i - 1] + checkpointTimeDelta;
 	}
 
-#ifdef ASAGI
+#if defined(DYNAMIC_DISPLACEMENTS)
+	// The scenario is kept to move the sea floor during the simulation
+	scenario = new SWE_AsagiScenario(bathymetryFilename, displacementFilename);
+	initScenario(*scenario, boundaries);
+#else
+#if defined(ASAGI)
 	SWE_AsagiScenario scenario(bathymetryFilename, displacementFilename);
+#elif defined(READNETCDF)
+	// Each chare reads only the input covering its block
+	SWE_NetCdfScenario scenario(bathymetryFilename, displacementFilename);
+	scenario.loadRegion(originX, originX + nx * dx, originY, originY + ny * dy);
 #else
 	SWE_RadialDamBreakScenario scenario = SWE_RadialDamBreakScenario();
 #endif
 	initScenario(scenario, boundaries);
+#endif
 
-	// Initialize writer
-	BoundarySize boundarySize = {{1, 1, 1, 1}};
-	writer = new NetCdfWriter(outputFilename, b, boundarySize, nx, ny, dx, dy, originX, originY);
+	connectedBoundaryCount = 0;
+	for (int i = 0; i < 4; i++) {
+		if (boundaryType[i] == CONNECT)
+			connectedBoundaryCount++;
+		recycledCopyLayer[i] = NULL;
+	}
+	pendingSendBuffers = 0;
 
 	// output at t=0
-	writeTimestep();
+	writeTimestep(0);
 
 	char hostname[HOST_NAME_MAX];
         gethostname(hostname, HOST_NAME_MAX);
@@ -80,7 +111,14 @@ SWE_DimensionalSplittingCharm::SWE_DimensionalSplittingCharm(int nx, int ny, flo
 	CkPrintf("%i Spawned at %s\n", thisIndex, hostname);
 }
 
-SWE_DimensionalSplittingCharm::~SWE_DimensionalSplittingCharm() {}
+SWE_DimensionalSplittingCharm::~SWE_DimensionalSplittingCharm() {
+	for (int i = 0; i < 4; i++) {
+		delete recycledCopyLayer[i];
+	}
+#ifdef DYNAMIC_DISPLACEMENTS
+	delete scenario;
+#endif
+}
 
 void SWE_DimensionalSplittingCharm::computeNumericalFluxes() {
 	// Start compute clocks
@@ -92,6 +130,20 @@ void SWE_DimensionalSplittingCharm::computeNumericalFluxes() {
 	float maxVerticalWaveSpeed = (float) 0.;
 	float maxWaveSpeed = (float) 0.;
 
+#ifdef CKLOOP
+	// Split the sweeps column-wise into chunks, which are picked up by the idle PEs of this node.
+	// The second sweep depends on the first one, so both loops are synchronous.
+	double maxSpeed = 0.;
+
+	// x-sweep, the columns 0..nx are the left cells of the nx + 1 edges
+	CkLoop_Parallelize(computeHorizontalNetUpdates, 1, this, loopChunkCount, 0, nx, 1, &maxSpeed, CKLOOP_DOUBLE_MAX);
+	maxHorizontalWaveSpeed = (float) maxSpeed;
+
+	// y-sweep
+	maxSpeed = 0.;
+	CkLoop_Parallelize(computeVerticalNetUpdates, 1, this, loopChunkCount, 1, nx, 1, &maxSpeed, CKLOOP_DOUBLE_MAX);
+	maxVerticalWaveSpeed = (float) maxSpeed;
+#else
 	#pragma omp parallel private(solver)
 	{
 		// x-sweep, compute the actual domain plus ghost rows above and below
@@ -126,6 +178,7 @@ void SWE_DimensionalSplittingCharm::computeNumericalFluxes() {
 			}
 		}
 	}
+#endif
 
 	// compute max timestep according to cautious CFL-condition
 	maxWaveSpeed = std::max(maxHorizontalWaveSpeed, maxVerticalWaveSpeed);
@@ -144,11 +197,96 @@ void SWE_DimensionalSplittingCharm::computeNumericalFluxes() {
 	computeTimeWall += (endTime.tv_sec - startTime.tv_sec);
 	computeTimeWall += (float) (endTime.tv_nsec - startTime.tv_nsec) / 1E9;
 
+}
+
+void SWE_DimensionalSplittingCharm::reduceTimestep() {
 	// Reduce over other ranks
 	CkCallback cb(CkReductionTarget(SWE_DimensionalSplittingCharm, reduceWaveSpeed), thisProxy);
 	contribute(sizeof(float), &maxTimestep, CkReduction::min_float, cb);
 }
 
+void SWE_DimensionalSplittingCharm::advance() {
+	if (!synchronizedWindow) {
+		// Check the fixed time step against the local CFL condition, violations are only reported at the end of the window.
+		// The computed time step includes the cautious factor .4, a violation does not necessarily mean the scheme became unstable.
+		if (windowTimestep > maxTimestep)
+			windowViolated = true;
+		windowLocalTimestep = std::min(windowLocalTimestep, maxTimestep);
+		maxTimestep = windowTimestep;
+	}
+
+	updateUnknowns(maxTimestep);
+
+	currentSimulationTime += maxTimestep;
+	iteration++;
+	stepsInWindow++;
+}
+
+void SWE_DimensionalSplittingCharm::startWindow() {
+	stepsInWindow = 0;
+	synchronizedWindow = (timestepWindow == 1) || recoverWindow;
+	if (synchronizedWindow)
+		return;
+
+	windowLocalTimestep = std::numeric_limits<float>::max();
+	windowViolated = false;
+
+	// Save the state for a rollback, the bathymetry does not change within a window
+	int size = (nx + 2) * (ny + 2);
+	windowStartTime = currentSimulationTime;
+	std::copy(h.getRawPointer(), h.getRawPointer() + size, windowH.getRawPointer());
+	std::copy(hu.getRawPointer(), hu.getRawPointer() + size, windowHu.getRawPointer());
+	std::copy(hv.getRawPointer(), hv.getRawPointer() + size, windowHv.getRawPointer());
+}
+
+void SWE_DimensionalSplittingCharm::verifyWindow() {
+	// A negative time step marks a violation, otherwise the smallest local time step of the window is reduced
+	float timestep = windowViolated ? -1.f : windowLocalTimestep;
+	CkCallback cb(CkReductionTarget(SWE_DimensionalSplittingCharm, reduceWaveSpeed), thisProxy);
+	contribute(sizeof(float), &timestep, CkReduction::min_float, cb);
+}
+
+void SWE_DimensionalSplittingCharm::finishWindow() {
+	if (timestepWindow == 1)
+		return;
+
+	// maxTimestep holds the result of the last reduction
+	if (!synchronizedWindow && maxTimestep < 0.) {
+		// Repeat the window with one reduction per iteration
+		int size = (nx + 2) * (ny + 2);
+		currentSimulationTime = windowStartTime;
+		std::copy(windowH.getRawPointer(), windowH.getRawPointer() + size, h.getRawPointer());
+		std::copy(windowHu.getRawPointer(), windowHu.getRawPointer() + size, hu.getRawPointer());
+		std::copy(windowHv.getRawPointer(), windowHv.getRawPointer() + size, hv.getRawPointer());
+		recoverWindow = true;
+
+		if (thisIndex == 0)
+			CkPrintf("CFL condition violated with time step %f, repeating %i iterations from %fs\n", windowTimestep, stepsInWindow, windowStartTime);
+	} else {
+		windowTimestep = timestepSafety * maxTimestep;
+		recoverWindow = false;
+	}
+}
+
+/**
+ * Moves the sea floor to the current simulation time and sends the new copy
+ * layers of the bathymetry to the neighbours if it changed.
+ *
+ * Windows are synchronized at their end, all chares therefore call this at
+ * the same simulation time and agree on whether the bathymetry is exchanged.
+ *
+ * @return true if the bathymetry of the ghost layers has to be received again.
+ */
+bool SWE_DimensionalSplittingCharm::updateSeaFloor() {
+#ifdef DYNAMIC_DISPLACEMENTS
+	if (updateDisplacement(*scenario, currentSimulationTime)) {
+		sendBathymetry();
+		return true;
+	}
+#endif
+	return false;
+}
+
 void SWE_DimensionalSplittingCharm::reduceWaveSpeed(float maxWaveSpeed) {
 	maxTimestep = maxWaveSpeed;
 	reductionTrigger();
@@ -163,6 +301,9 @@ void SWE_DimensionalSplittingCharm::updateUnknowns(float dt) {
 	assert(std::abs(dt - maxTimestep) < 0.00001);
 
 	// update cell averages with the net-updates
+#ifdef CKLOOP
+	CkLoop_Parallelize(updateColumns, 1, this, loopChunkCount, 1, nx);
+#else
 	#pragma omp parallel for collapse(2)
 	for (int x = 1; x < nx + 1; x++) {
 		for (int y = 1; y < ny + 1; y++) {
@@ -171,6 +312,7 @@ void SWE_DimensionalSplittingCharm::updateUnknowns(float dt) {
 			hv[x][y] -= (dt / dy) * (hvNetUpdatesAbove[x][y] + hvNetUpdatesBelow[x][y]);
 		}
 	}
+#endif
 
 	// Accumulate compute time
 	computeClock = clock() - computeClock;
@@ -181,152 +323,243 @@ void SWE_DimensionalSplittingCharm::updateUnknowns(float dt) {
 	computeTimeWall += (float) (endTimeCompute.tv_nsec - startTimeCompute.tv_nsec) / 1E9;
 }
 
-void SWE_DimensionalSplittingCharm::processCopyLayer(copyLayer *msg) {
-	// LEFT ghost layer consists of values from the left neighbours RIGHT copy layer etc.
-	if (msg->boundary == BND_RIGHT && boundaryType[BND_LEFT] == CONNECT) {
-		for (int i = 0; i < ny; i++) {
-			if (msg->containsBathymetry)
-				b[0][i + 1] = msg->b[i];
-			h[0][i + 1] = msg->h[i];
-			hu[0][i + 1] = msg->hu[i];
-			hv[0][i + 1] = msg->hv[i];
+#ifdef CKLOOP
+void SWE_DimensionalSplittingCharm::computeHorizontalNetUpdates(int first, int last, void *result, int paramNum, void *param) {
+	SWE_DimensionalSplittingCharm *block = (SWE_DimensionalSplittingCharm *) param;
+	// The solver keeps intermediate state, every chunk needs its own instance
+	solver::Hybrid<float> localSolver;
+	float maxWaveSpeed = (float) 0.;
+
+	for (int x = first; x <= last; x++) {
+		for (int y = 1; y < block->ny + 1; y++) {
+			localSolver.computeNetUpdates (
+					block->h[x][y], block->h[x + 1][y],
+					block->hu[x][y], block->hu[x + 1][y],
+					block->b[x][y], block->b[x + 1][y],
+					block->hNetUpdatesLeft[x][y], block->hNetUpdatesRight[x + 1][y],
+					block->huNetUpdatesLeft[x][y], block->huNetUpdatesRight[x + 1][y],
+					maxWaveSpeed
+					);
+		}
+	}
+	*(double *) result = maxWaveSpeed;
+}
+
+void SWE_DimensionalSplittingCharm::computeVerticalNetUpdates(int first, int last, void *result, int paramNum, void *param) {
+	SWE_DimensionalSplittingCharm *block = (SWE_DimensionalSplittingCharm *) param;
+	solver::Hybrid<float> localSolver;
+	float maxWaveSpeed = (float) 0.;
+
+	for (int x = first; x <= last; x++) {
+		for (int y = 0; y < block->ny + 1; y++) {
+			localSolver.computeNetUpdates (
+					block->h[x][y], block->h[x][y + 1],
+					block->hv[x][y], block->hv[x][y + 1],
+					block->b[x][y], block->b[x][y + 1],
+					block->hNetUpdatesBelow[x][y], block->hNetUpdatesAbove[x][y + 1],
+					block->hvNetUpdatesBelow[x][y], block->hvNetUpdatesAbove[x][y + 1],
+					maxWaveSpeed
+					);
 		}
-	} else if (msg->boundary == BND_LEFT && boundaryType[BND_RIGHT] == CONNECT) {
-		for (int i = 0; i < ny; i++) {
-			if (msg->containsBathymetry)
-				b[nx + 1][i + 1] = msg->b[i];
-			h[nx + 1][i + 1] = msg->h[i];
-			hu[nx + 1][i + 1] = msg->hu[i];
-			hv[nx + 1][i + 1] = msg->hv[i];
+	}
+	*(double *) result = maxWaveSpeed;
+}
+
+void SWE_DimensionalSplittingCharm::updateColumns(int first, int last, void *result, int paramNum, void *param) {
+	SWE_DimensionalSplittingCharm *block = (SWE_DimensionalSplittingCharm *) param;
+	// updateUnknowns() asserts that the time step equals maxTimestep
+	float dt = block->maxTimestep;
+	float dx = block->dx;
+	float dy = block->dy;
+
+	for (int x = first; x <= last; x++) {
+		for (int y = 1; y < block->ny + 1; y++) {
+			block->h[x][y] -= (dt / dx) * (block->hNetUpdatesRight[x][y] + block->hNetUpdatesLeft[x][y])
+					+ (dt / dy) * (block->hNetUpdatesAbove[x][y] + block->hNetUpdatesBelow[x][y]);
+			block->hu[x][y] -= (dt / dx) * (block->huNetUpdatesRight[x][y] + block->huNetUpdatesLeft[x][y]);
+			block->hv[x][y] -= (dt / dy) * (block->hvNetUpdatesAbove[x][y] + block->hvNetUpdatesBelow[x][y]);
 		}
-	} else if (msg->boundary == BND_TOP && boundaryType[BND_BOTTOM] == CONNECT) {
+	}
+}
+#endif
+
+void SWE_DimensionalSplittingCharm::processBathymetry(Boundary boundary, int size, float *data) {
+	// LEFT ghost layer consists of values from the left neighbours RIGHT copy layer etc.
+	if (boundary == BND_RIGHT && boundaryType[BND_LEFT] == CONNECT) {
+		assert(size == ny);
+		std::copy(data, data + size, &b[0][1]);
+	} else if (boundary == BND_LEFT && boundaryType[BND_RIGHT] == CONNECT) {
+		assert(size == ny);
+		std::copy(data, data + size, &b[nx + 1][1]);
+	} else if (boundary == BND_TOP && boundaryType[BND_BOTTOM] == CONNECT) {
+		assert(size == nx);
+		for (int i = 0; i < nx; i++)
+			b[i + 1][0] = data[i];
+	} else if (boundary == BND_BOTTOM && boundaryType[BND_TOP] == CONNECT) {
+		assert(size == nx);
+		for (int i = 0; i < nx; i++)
+			b[i + 1][ny + 1] = data[i];
+	}
+}
+
+void SWE_DimensionalSplittingCharm::processGhostColumn(Boundary boundary, float *ghostH, float *ghostHu, float *ghostHv) {
+	// The LEFT ghost layer is filled by the left neighbours RIGHT copy layer, which arrives at receiveGhostLeft
+	int x = (boundary == BND_LEFT) ? 0 : nx + 1;
+	std::copy(ghostH, ghostH + ny, &h[x][1]);
+	std::copy(ghostHu, ghostHu + ny, &hu[x][1]);
+	std::copy(ghostHv, ghostHv + ny, &hv[x][1]);
+}
+
+void SWE_DimensionalSplittingCharm::processCopyLayer(copyLayer *msg) {
+	// BOTTOM ghost layer consists of values from the bottom neighbours TOP copy layer etc.
+	if (msg->boundary == BND_TOP && boundaryType[BND_BOTTOM] == CONNECT) {
 		for (int i = 0; i < nx; i++) {
-			if (msg->containsBathymetry)
-				b[i + 1][0] = msg->b[i];
 			h[i + 1][0] = msg->h[i];
 			hu[i + 1][0] = msg->hu[i];
 			hv[i + 1][0] = msg->hv[i];
 		}
+		// Keep the message buffer, the next copy layer for the bottom neighbour has the same size
+		recycledCopyLayer[BND_BOTTOM] = msg;
 	} else if (msg->boundary == BND_BOTTOM && boundaryType[BND_TOP] == CONNECT) {
 		for (int i = 0; i < nx; i++) {
-			if (msg->containsBathymetry)
-				b[i + 1][ny + 1] = msg->b[i];
 			h[i + 1][ny + 1] = msg->h[i];
 			hu[i + 1][ny + 1] = msg->hu[i];
 			hv[i + 1][ny + 1] = msg->hv[i];
 		}
+		recycledCopyLayer[BND_TOP] = msg;
+	} else {
+		// Deallocate the message buffer
+		delete msg;
 	}
-
-	// Deallocate the message buffer
-	delete msg;
 }
 
-void SWE_DimensionalSplittingCharm::sendCopyLayers(bool sendBathymetry) {
-	// The array sizes for copy layers of either orientation, set bathymetry array to length zero
-	int sizesVertical[] = {0, ny, ny, ny};
-	int sizesHorizontal[] = {0, nx, nx, nx};
+void SWE_DimensionalSplittingCharm::sendBathymetry() {
+	// Left and right copy layers are contiguous due to Float2D being column-major
+	if (boundaryType[BND_LEFT] == CONNECT) {
+		assert(neighbourIndex[BND_LEFT] > -1);
+		thisProxy[neighbourIndex[BND_LEFT]].receiveBathymetry(BND_LEFT, ny, &b[1][1]);
+	}
+	if (boundaryType[BND_RIGHT] == CONNECT) {
+		assert(neighbourIndex[BND_RIGHT] > -1);
+		thisProxy[neighbourIndex[BND_RIGHT]].receiveBathymetry(BND_RIGHT, ny, &b[nx][1]);
+	}
 
-	// If we are sending bathymetry too, change the bathymetry array sizes from 0 to the respective value
-	if (sendBathymetry) {
-		sizesVertical[0] = ny;
-		sizesHorizontal[0] = nx;
+	// Bottom and top copy layers are strided, gather them first
+	std::vector<float> row(nx);
+	if (boundaryType[BND_BOTTOM] == CONNECT) {
+		assert(neighbourIndex[BND_BOTTOM] > -1);
+		for (int i = 0; i < nx; i++)
+			row[i] = b[i + 1][1];
+		thisProxy[neighbourIndex[BND_BOTTOM]].receiveBathymetry(BND_BOTTOM, nx, row.data());
 	}
+	if (boundaryType[BND_TOP] == CONNECT) {
+		assert(neighbourIndex[BND_TOP] > -1);
+		for (int i = 0; i < nx; i++)
+			row[i] = b[i + 1][ny];
+		thisProxy[neighbourIndex[BND_TOP]].receiveBathymetry(BND_TOP, nx, row.data());
+	}
+}
 
-	int size, stride, startIndex, endIndex;
+void SWE_DimensionalSplittingCharm::sendCopyLayers() {
+	// The array sizes for copy layers of horizontal orientation
+	int sizesHorizontal[] = {nx, nx, nx};
 
-	if (boundaryType[BND_LEFT] == CONNECT) {
-		assert(neighbourIndex[BND_LEFT] > -1);
+	int stride = ny + 2;
+	int startIndex;
 
-		copyLayer *left = new(sizesVertical, 0) copyLayer();
-		left->containsBathymetry = sendBathymetry;
-		left->boundary = BND_LEFT;
+	// Left and right copy layers are contiguous (Float2D is column-major) and handed to the runtime without a copy.
+	// Each buffer is released through sendBufferReleased(), updateUnknowns() must not run before.
+	CkCallback released(CkIndex_SWE_DimensionalSplittingCharm::sendBufferReleased(NULL), thisProxy[thisIndex]);
+	pendingSendBuffers = 0;
 
-		// Fill left (stride 1, contiguous storage due to Float2D being column-major)
-		size = ny;
-		startIndex = ny + 2 + 1;
-		endIndex = startIndex + size;
-		if (sendBathymetry)
-			std::copy(b.getRawPointer() + startIndex, b.getRawPointer() + endIndex, left->b);
-		std::copy(h.getRawPointer() + startIndex, h.getRawPointer() + endIndex, left->h);
-		std::copy(hu.getRawPointer() + startIndex, hu.getRawPointer() + endIndex, left->hu);
-		std::copy(hv.getRawPointer() + startIndex, hv.getRawPointer() + endIndex, left->hv);
+	if (boundaryType[BND_LEFT] == CONNECT) {
+		assert(neighbourIndex[BND_LEFT] > -1);
 
-		// Send
-		thisProxy[neighbourIndex[BND_LEFT]].receiveGhostRight(left);
+		thisProxy[neighbourIndex[BND_LEFT]].receiveGhostRight(iteration, ny,
+				CkSendBuffer(&h[1][1], released),
+				CkSendBuffer(&hu[1][1], released),
+				CkSendBuffer(&hv[1][1], released));
+		pendingSendBuffers += 3;
 	}
 
 	if (boundaryType[BND_RIGHT] == CONNECT) {
 		assert(neighbourIndex[BND_RIGHT] > -1);
 
-		copyLayer *right = new(sizesVertical, 0) copyLayer();
-		right->containsBathymetry = sendBathymetry;
-		right->boundary = BND_RIGHT;
-
-		// Fill right (stride 1, contiguous storage due to Float2D being column-major)
-		size = ny;
-		startIndex = nx * (ny + 2) + 1;
-		endIndex = startIndex + size;
-		if (sendBathymetry)
-			std::copy(b.getRawPointer() + startIndex, b.getRawPointer() + endIndex, right->b);
-		std::copy(h.getRawPointer() + startIndex, h.getRawPointer() + endIndex, right->h);
-		std::copy(hu.getRawPointer() + startIndex, hu.getRawPointer() + endIndex, right->hu);
-		std::copy(hv.getRawPointer() + startIndex, hv.getRawPointer() + endIndex, right->hv);
-
-		// Send
-		thisProxy[neighbourIndex[BND_RIGHT]].receiveGhostLeft(right);
+		thisProxy[neighbourIndex[BND_RIGHT]].receiveGhostLeft(iteration, ny,
+				CkSendBuffer(&h[nx][1], released),
+				CkSendBuffer(&hu[nx][1], released),
+				CkSendBuffer(&hv[nx][1], released));
+		pendingSendBuffers += 3;
 	}
 
 	if (boundaryType[BND_BOTTOM] == CONNECT) {
 		assert(neighbourIndex[BND_BOTTOM] > -1);
 
-		copyLayer *bottom = new(sizesHorizontal, 0) copyLayer();
-		bottom->containsBathymetry = sendBathymetry;
+		// Reuse the message received from the bottom neighbour in the previous iteration if there is one
+		copyLayer *bottom = recycledCopyLayer[BND_BOTTOM];
+		if (bottom == NULL)
+			bottom = new(sizesHorizontal, 0) copyLayer();
+		recycledCopyLayer[BND_BOTTOM] = NULL;
 		bottom->boundary = BND_BOTTOM;
 
 		// Fill bottom
-		size = nx;
-		stride = ny + 2;
 		startIndex = ny + 2 + 1;
-		endIndex = startIndex + size;
-		for (int i = 0; i < size; i++) {
-			if (sendBathymetry)
-				*(bottom->b + i) = *(b.getRawPointer() + startIndex + i * stride);
-			*(bottom->h + i) = *(h.getRawPointer() + startIndex + i * stride);
-			*(bottom->hu + i) = *(hu.getRawPointer() + startIndex + i * stride);
-			*(bottom->hv + i) = *(hv.getRawPointer() + startIndex + i * stride);
+		const float *srcH = h.getRawPointer() + startIndex;
+		const float *srcHu = hu.getRawPointer() + startIndex;
+		const float *srcHv = hv.getRawPointer() + startIndex;
+		for (int i = 0; i < nx; i++) {
+			bottom->h[i] = srcH[i * stride];
+			bottom->hu[i] = srcHu[i * stride];
+			bottom->hv[i] = srcHv[i * stride];
 		}
 
 		// Send
+		CkSetRefNum(bottom, iteration);
 		thisProxy[neighbourIndex[BND_BOTTOM]].receiveGhostTop(bottom);
 	}
 
 	if (boundaryType[BND_TOP] == CONNECT) {
 		assert(neighbourIndex[BND_TOP] > -1);
 
-		copyLayer *top = new(sizesHorizontal, 0) copyLayer();
-		top->containsBathymetry = sendBathymetry;
+		copyLayer *top = recycledCopyLayer[BND_TOP];
+		if (top == NULL)
+			top = new(sizesHorizontal, 0) copyLayer();
+		recycledCopyLayer[BND_TOP] = NULL;
 		top->boundary = BND_TOP;
 
 		// Fill top
-		size = nx;
-		stride = ny + 2;
 		startIndex = ny + 2 + ny;
-		endIndex = startIndex + size;
-		for (int i = 0; i < size; i++) {
-			if (sendBathymetry)
-				*(top->b + i) = *(b.getRawPointer() + startIndex + i * stride);
-			*(top->h + i) = *(h.getRawPointer() + startIndex + i * stride);
-			*(top->hu + i) = *(hu.getRawPointer() + startIndex + i * stride);
-			*(top->hv + i) = *(hv.getRawPointer() + startIndex + i * stride);
+		const float *srcH = h.getRawPointer() + startIndex;
+		const float *srcHu = hu.getRawPointer() + startIndex;
+		const float *srcHv = hv.getRawPointer() + startIndex;
+		for (int i = 0; i < nx; i++) {
+			top->h[i] = srcH[i * stride];
+			top->hu[i] = srcHu[i * stride];
+			top->hv[i] = srcHv[i * stride];
 		}
 
 		// Send
+		CkSetRefNum(top, iteration);
 		thisProxy[neighbourIndex[BND_TOP]].receiveGhostBottom(top);
 	}
 }
 
-void SWE_DimensionalSplittingCharm::writeTimestep() {
-	writer->writeTimeStep(h, hu, hv, currentSimulationTime);
+void SWE_DimensionalSplittingCharm::writeTimestep(int checkpoint) {
+	// Hand a copy of the grids to the writer, the simulation continues while it is written.
+	// The bathymetry is static and only sent with the initial snapshot.
+	int size = (nx + 2) * (ny + 2);
+	int sizes[] = {size, size, size, (checkpoint == 0) ? size : 0};
+	snapshot *msg = new(sizes, 0) snapshot();
+
+	msg->time = currentSimulationTime;
+	std::copy(h.getRawPointer(), h.getRawPointer() + size, msg->h);
+	std::copy(hu.getRawPointer(), hu.getRawPointer() + size, msg->hu);
+	std::copy(hv.getRawPointer(), hv.getRawPointer() + size, msg->hv);
+	if (checkpoint == 0)
+		std::copy(b.getRawPointer(), b.getRawPointer() + size, msg->b);
+
+	CkSetRefNum(msg, checkpoint);
+	writerProxy[thisIndex].receiveSnapshot(msg);
 }
 
 void SWE_DimensionalSplittingCharm::setGhostLayer() {
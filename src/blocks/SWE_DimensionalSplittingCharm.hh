@@ -7,23 +7,35 @@
 #include <limits.h>
 #include <ctime>
 #include <time.h>
+#include <vector>
+#include <limits>
 #include "blocks/SWE_Block.hh"
-#ifdef ASAGI
+#if defined(ASAGI)
 #include "scenarios/SWE_AsagiScenario.hh"
+#elif defined(READNETCDF)
+#include "scenarios/SWE_NetCdfScenario.hh"
 #else
 #include "scenarios/SWE_simple_scenarios.hh"
 #endif
 #include "examples/swe_charm.decl.h"
 #include "types/Boundary.hh"
-#include "writer/NetCdfWriter.hh"
+#include "writer/CheckpointWriterCharm.hh"
 #include "tools/Float2DNative.hh"
 #include "solvers/Hybrid.hpp"
 
+#ifdef CKLOOP
+#include "CkLoopAPI.h"
+#endif
+
 extern CProxy_swe_charm mainProxy;
+extern CProxy_CheckpointWriterCharm writerProxy;
 extern int blockCountX;
 extern int blockCountY;
 extern float simulationDuration;
 extern int checkpointCount;
+extern int loopChunkCount;
+extern int timestepWindow;
+extern float timestepSafety;
 
 class SWE_DimensionalSplittingCharm : public CBase_SWE_DimensionalSplittingCharm, public SWE_Block<Float2DNative>  {
 
@@ -34,26 +46,56 @@ class SWE_DimensionalSplittingCharm : public CBase_SWE_DimensionalSplittingCharm
 		SWE_DimensionalSplittingCharm(CkMigrateMessage *msg);
 		SWE_DimensionalSplittingCharm(int cellCountHorizontal, int cellCountVertical, float cellSizeHorizontal, float cellSizeVertical,
 						float originX, float originY, int posX, int posY, BoundaryType boundaries[],
-						std::string outputFileName, std::string bathymetryFileName = "", std::string displacementFileName = "");
+						std::string bathymetryFileName = "", std::string displacementFileName = "");
 		~SWE_DimensionalSplittingCharm();
 
 		// Charm++ entry methods
 		void reduceWaveSpeed(float maxWaveSpeed);
 
 	private:
-		void writeTimestep();
-		void sendCopyLayers(bool sendBathymetry = false);
+		void writeTimestep(int checkpoint);
+		void sendBathymetry();
+		void processBathymetry(Boundary boundary, int size, float *data);
+		void sendCopyLayers();
+		void processGhostColumn(Boundary boundary, float *ghostH, float *ghostHu, float *ghostHv);
 		void processCopyLayer(copyLayer *msg);
 		void computeNumericalFluxes();
+		void reduceTimestep();
+		void advance();
 		void updateUnknowns(float dt);
+
+		// Time step windows
+		void startWindow();
+		void verifyWindow();
+		void finishWindow();
+		// Time-dependent displacement
+		bool updateSeaFloor();
 		// Interface implementation
 		void setGhostLayer();
 
+#ifdef CKLOOP
+		// CkLoop helpers, each processing the columns [first, last] of the block passed in param
+		static void computeHorizontalNetUpdates(int first, int last, void *result, int paramNum, void *param);
+		static void computeVerticalNetUpdates(int first, int last, void *result, int paramNum, void *param);
+		static void updateColumns(int first, int last, void *result, int paramNum, void *param);
+#endif
+
 		solver::Hybrid<float> solver;
 		float *checkpointInstantOfTime;
-		NetCdfWriter *writer;
 		float currentSimulationTime;
 		int currentCheckpoint;
+		// Global iteration count, used as reference number of the copy layer messages
+		int iteration;
+
+		// Time step windows: timestepWindow iterations are computed with a fixed time step,
+		// which is derived from the previous window and checked against the local CFL condition afterwards.
+		// A window is synchronized (one reduction per iteration) at the start or after a rollback.
+		bool synchronizedWindow;
+		bool recoverWindow;
+		int stepsInWindow;
+		float windowTimestep;
+		float windowLocalTimestep;
+		bool windowViolated;
 
 		// net updates per cell
 		Float2DNative hNetUpdatesLeft;
@@ -68,8 +110,30 @@ class SWE_DimensionalSplittingCharm : public CBase_SWE_DimensionalSplittingCharm
 		Float2DNative hvNetUpdatesBelow;
 		Float2DNative hvNetUpdatesAbove;
 
+		// State at the start of the window, restored on a rollback
+		float windowStartTime;
+		Float2DNative windowH;
+		Float2DNative windowHu;
+		Float2DNative windowHv;
+
 		// Interfaces to neighbouring block copy layers, indexed by Boundary
 		int neighbourIndex[4];
+		int connectedBoundaryCount;
+
+#ifdef DYNAMIC_DISPLACEMENTS
+		// Scenario providing the time-dependent displacement
+		SWE_Scenario *scenario;
+#endif
+		// True if the bathymetry changed at the end of the current window
+		bool seaFloorMoved;
+
+		// Loop counters of the SDAG code
+		int receivedBathymetryLayers;
+		int pendingSendBuffers;
+		int releasedSendBuffers;
+
+		// Received bottom/top copy layer messages, reused to send to the same neighbour in the next iteration
+		copyLayer *recycledCopyLayer[4];
 
 		// timer
 		std::clock_t computeClock;
@@ -88,8 +152,6 @@ class SWE_DimensionalSplittingCharm : public CBase_SWE_DimensionalSplittingCharm
 class copyLayer : public CMessage_copyLayer {
 	public:
 		Boundary boundary;
-		bool containsBathymetry;
-		float *b;
 		float *h;
 		float *hu;
 		float *hv;
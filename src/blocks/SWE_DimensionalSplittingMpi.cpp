@@ -388,6 +388,10 @@ void SWE_DimensionalSplittingMpi::updateUnknowns (float dt) {
 	// this assertion has to hold since the intermediary star states were calculated internally using a timestep width of maxTimestep
 	assert(std::abs(dt - maxTimestep) < 0.00001);
 
+	// the in-situ products are updated in the same pass
+	const bool accumulate = envelope;
+	const float time = envelopeTime + dt;
+
 	// update cell averages with the net-updates
 	#pragma omp parallel for collapse(2)
 	for (int x = 1; x < nx + 1; x++) {
@@ -395,8 +399,11 @@ void SWE_DimensionalSplittingMpi::updateUnknowns (float dt) {
 			h[x][y] -= (dt / dx) * (hNetUpdatesRight[x][y] + hNetUpdatesLeft[x][y]) + (dt / dy) * (hNetUpdatesAbove[x][y] + hNetUpdatesBelow[x][y]);
 			hu[x][y] -= (dt / dx) * (huNetUpdatesRight[x][y] + huNetUpdatesLeft[x][y]);
 			hv[x][y] -= (dt / dy) * (hvNetUpdatesAbove[x][y] + hvNetUpdatesBelow[x][y]);
+			if (accumulate)
+				accumulateEnvelope(x, y, time);
 		}
 	}
+	envelopeTime = time;
 
 	// Accumulate compute time
 	computeClock = clock() - computeClock;
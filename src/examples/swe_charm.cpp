@@ -44,17 +44,23 @@
 #include "tools/Float2D.hh"
 #include "tools/Logger.hh"
 #include "tools/ProgressBar.hh"
-#ifdef ASAGI
+#if defined(ASAGI)
 #include "scenarios/SWE_AsagiScenario.hh"
+#elif defined(READNETCDF)
+#include "scenarios/SWE_NetCdfScenario.hh"
 #else
 #include "scenarios/SWE_simple_scenarios.hh"
 #endif
 
 /* readonly */ CProxy_swe_charm mainProxy;
+/* readonly */ CProxy_CheckpointWriterCharm writerProxy;
 /* readonly */ int blockCountX;
 /* readonly */ int blockCountY;
 /* readonly */ float simulationDuration;
 /* readonly */ int checkpointCount;
+/* readonly */ int loopChunkCount;
+/* readonly */ int timestepWindow;
+/* readonly */ float timestepSafety;
 
 swe_charm::swe_charm(CkMigrateMessage *msg) {}
 
@@ -69,7 +75,7 @@ swe_charm::swe_charm(CkArgMsg *msg) {
 	// Define command line arguments
 	tools::Args args;
 
-#ifdef ASAGI
+#if defined(ASAGI) || defined(READNETCDF)
 	args.addOption("bathymetry-file", 'b', "File containing the bathymetry");
 	args.addOption("displacement-file", 'd', "File containing the displacement");
 #endif
@@ -78,6 +84,13 @@ swe_charm::swe_charm(CkArgMsg *msg) {
 	args.addOption("resolution-horizontal", 'x', "Number of simulation cells in horizontal direction");
 	args.addOption("resolution-vertical", 'y', "Number of simulated cells in y-direction");
 	args.addOption("output-basepath", 'o', "Output base file name");
+	args.addOption("timestep-window", 'w', "Number of iterations computed with a fixed time step between two global time step reductions (default 1)", tools::Args::Required, false);
+	args.addOption("timestep-safety", 's', "Factor applied to the time step of the previous window (default 0.9)", tools::Args::Required, false);
+	args.addOption("io-pes", 'i', "Number of PEs reserved for checkpoint writers, by default writers share the PEs of the blocks", tools::Args::Required, false);
+	args.addOption("chare-count", 'c', "Number of simulation blocks (chares), defaults to the number of PEs", tools::Args::Required, false);
+#ifdef CKLOOP
+	args.addOption("loop-chunks", 'l', "Number of CkLoop chunks per sweep inside a chare, defaults to the number of PEs per node", tools::Args::Required, false);
+#endif
 
 
 	// Declare the variables needed to hold command line input
@@ -108,15 +121,39 @@ swe_charm::swe_charm(CkArgMsg *msg) {
 	checkpointCount = args.getArgument<int>("checkpoint-count");
 	nxRequested = args.getArgument<int>("resolution-horizontal");
 	nyRequested = args.getArgument<int>("resolution-vertical");
-#ifdef ASAGI
+#if defined(ASAGI) || defined(READNETCDF)
 	bathymetryFilename = args.getArgument<std::string>("bathymetry-file");
 	displacementFilename = args.getArgument<std::string>("displacement-file");
 #endif
 	outputBasename = args.getArgument<std::string>("output-basepath");
+	timestepWindow = args.getArgument<int>("timestep-window", 1);
+	timestepSafety = args.getArgument<float>("timestep-safety", 0.9f);
+	if (timestepWindow < 1)
+		CkAbort("The time step window has to contain at least one iteration\n");
+	if (timestepSafety <= 0.f || timestepSafety > 1.f)
+		CkAbort("The time step safety factor has to be in (0, 1]\n");
+	ioPeCount = args.getArgument<int>("io-pes", 0);
+	if (ioPeCount < 0 || ioPeCount >= CkNumPes())
+		CkAbort("The number of I/O PEs has to be smaller than the number of PEs\n");
+	computePeCount = CkNumPes() - ioPeCount;
+
+	// Spawn one chare per compute PE unless requested otherwise
+	chareCount = args.getArgument<int>("chare-count", computePeCount);
+#ifdef CKLOOP
+	loopChunkCount = args.getArgument<int>("loop-chunks", CkMyNodeSize());
+
+	// The sweeps of a chare are split into chunks which are executed by idle PEs of the same node
+	CkLoop_Init();
+#else
+	loopChunkCount = 1;
+#endif
 
 	// Initialize Scenario
-#ifdef ASAGI
+#if defined(ASAGI)
 	SWE_AsagiScenario scenario(bathymetryFilename, displacementFilename);
+#elif defined(READNETCDF)
+	// Only reads the extent of the domain, each chare reads its own part of the input
+	SWE_NetCdfScenario scenario(bathymetryFilename, displacementFilename);
 #else
 	SWE_RadialDamBreakScenario scenario;
 #endif
@@ -126,8 +163,6 @@ swe_charm::swe_charm(CkArgMsg *msg) {
 	 * INIT WORK CHARES / SIMULATION BLOCKS *
 	 ****************************************/
 
-	// Spawn one chare per CPU
-	chareCount = CkNumPes();
 	mainProxy = thisProxy;
 
 	/*
@@ -140,8 +175,9 @@ swe_charm::swe_charm(CkArgMsg *msg) {
 	float dxSimulation = (float) widthScenario / nxRequested;
 	float dySimulation = (float) heightScenario / nyRequested;
 
-	// Declare empty proxy array (dynamic insertion after parameters have been determined)
+	// Declare empty proxy arrays (dynamic insertion after parameters have been determined)
 	CProxy_SWE_DimensionalSplittingCharm blocks = CProxy_SWE_DimensionalSplittingCharm::ckNew();
+	writerProxy = CProxy_CheckpointWriterCharm::ckNew();
 
 	// number of SWE-Blocks in x- and y-direction
 	blockCountY = std::sqrt(chareCount);
@@ -184,21 +220,35 @@ swe_charm::swe_charm(CkArgMsg *msg) {
 
 		outputFilename = generateBaseFileName(outputBasename, localBlockPositionX[i], localBlockPositionY[i]);
 
+		// Spawn the checkpoint writer of the current block, on one of the reserved I/O PEs if there are any
+		if (ioPeCount > 0) {
+			writerProxy[i].insert(nxLocal, nyLocal, dxSimulation, dySimulation, localOriginX, localOriginY, outputFilename,
+					      computePeCount + i % ioPeCount);
+		} else {
+			writerProxy[i].insert(nxLocal, nyLocal, dxSimulation, dySimulation, localOriginX, localOriginY, outputFilename);
+		}
+
 		// Spawn chare for the current block and insert it into the proxy array
-#ifdef ASAGI
+		// (blocks are kept away from the I/O PEs)
+#if defined(ASAGI) || defined(READNETCDF)
 		blocks[i].insert(nxLocal, nyLocal, dxSimulation, dySimulation, localOriginX, localOriginY, localBlockPositionX[i], localBlockPositionY[i],
-				 boundaries, outputFilename, bathymetryFilename, displacementFilename);
+				 boundaries, bathymetryFilename, displacementFilename, i % computePeCount);
 #else
 		blocks[i].insert(nxLocal, nyLocal, dxSimulation, dySimulation, localOriginX, localOriginY, localBlockPositionX[i], localBlockPositionY[i],
-				 boundaries, outputFilename, "", "");
+				 boundaries, "", "", i % computePeCount);
 #endif
 	}
+	writerProxy.doneInserting();
+	writerProxy.write();
 	blocks.doneInserting();
 	blocks.compute();
+
+	// Every block and every writer reports when it is done
+	runningChareCount = 2 * chareCount;
 }
 
 void swe_charm::done(int index) {
-	if (--chareCount == 0)
+	if (--runningChareCount == 0)
 		exit();
 }
 void swe_charm::exit() {
@@ -3,6 +3,10 @@
 
 #include "swe_charm.decl.h"
 
+#ifdef CKLOOP
+#include "CkLoopAPI.h"
+#endif
+
 class swe_charm : public CBase_swe_charm {
 	public:
 		swe_charm(CkArgMsg *msg);
@@ -13,5 +17,8 @@ class swe_charm : public CBase_swe_charm {
 
 	private:
 		int chareCount;
+		int runningChareCount;
+		int ioPeCount;
+		int computePeCount;
 };
 #endif // __SWE_CHARM_HH
@@ -36,20 +36,30 @@
 #include <time.h>
 #include <unistd.h>
 #include <limits.h>
+#include <vector>
 
 #include "tools/args.hh"
 
-#ifdef WRITENETCDF
+#if defined(STREAM_OUTPUT)
+#include "writer/StreamWriter.hh"
+#elif defined(WRITENETCDF)
 #include "writer/NetCdfWriter.hh"
 #else
 #include "writer/VtkWriter.hh"
 #endif
+#ifdef ASYNC_WRITER
+#include "writer/AsyncWriter.hh"
+#endif
+#include "writer/GaugeWriter.hh"
 
-#ifdef ASAGI
+#if defined(ASAGI)
 #include "scenarios/SWE_AsagiScenario.hh"
+#elif defined(READNETCDF)
+#include "scenarios/SWE_NetCdfScenario.hh"
 #else
 #include "scenarios/SWE_simple_scenarios.hh"
 #endif
+#include "scenarios/SWE_RestartScenario.hh"
 
 #include "blocks/SWE_DimensionalSplittingMpi.hh"
 #include <mpi.h>
@@ -65,15 +75,56 @@ int main(int argc, char** argv) {
 	// Define command line arguments
 	tools::Args args;
 
-#ifdef ASAGI
+#if defined(ASAGI) || defined(READNETCDF)
 	args.addOption("bathymetry-file", 'b', "File containing the bathymetry");
 	args.addOption("displacement-file", 'd', "File containing the displacement");
+	args.addOption("bathymetry-cache", 0, "Binary file with the bathymetry sampled on the simulation grid, created if it does not match (one file per bathymetry)", tools::Args::Required, false);
+	args.addOption("preprocess", 0, "Only create the bathymetry cache", tools::Args::No, false);
+	args.addOption("build-pyramid", 0, "Only build this many coarsened copies of the bathymetry, each with half the resolution of the previous one", tools::Args::Required, false);
+#endif
+#ifdef READNETCDF
+	args.addOption("input-cache", 0, "Stream the input in tiles, keeping at most this many MB of each input file in memory", tools::Args::Required, false);
+	args.addOption("resampling", 0, "Sampling of the input on the cells: nearest, bilinear or conservative (default nearest)", tools::Args::Required, false);
+#endif
+#if defined(READNETCDF) && !defined(AMPI)
+	args.addOption("share-input", 0, "Read the input once per node and share it between the ranks of the node", tools::Args::No, false);
 #endif
 	args.addOption("simulation-duration", 't', "Time in seconds to simulate");
 	args.addOption("checkpoint-count", 'n', "Number of simulation snapshots to be written");
 	args.addOption("resolution-horizontal", 'x', "Number of simulation cells in horizontal direction");
 	args.addOption("resolution-vertical", 'y', "Number of simulated cells in y-direction");
 	args.addOption("output-basepath", 'o', "Output base file name");
+	args.addOption("output-interval", 0, "Write the full output every n-th checkpoint, 0 disables it (default 1)", tools::Args::Required, false);
+	args.addOption("output-region", 0, "Additional outputs xmin,xmax,ymin,ymax[,stride[,interval]], separated by ';'", tools::Args::Required, false);
+	args.addOption("output-fields", 0, "Written fields out of h,hu,hv,eta,speed,froude (default h,hu,hv)", tools::Args::Required, false);
+	args.addOption("gauges", 0, "File with gauge locations (one \"x y\" per line) recorded after every time step", tools::Args::Required, false);
+	args.addOption("gauge-flush", 0, "Number of time steps buffered before the gauges are written (default 100)", tools::Args::Required, false);
+	args.addOption("restart", 0, "Resume from the restart files of an earlier run with this output base name (same number of ranks)", tools::Args::Required, false);
+	args.addOption("restart-interval", 0, "Write restart files every n-th checkpoint, 0 disables them (default 0)", tools::Args::Required, false);
+	args.addOption("restart-full-interval", 0, "Every n-th restart file contains the complete state, the others only the tiles changed since the previous one (default 1)", tools::Args::Required, false);
+	args.addOption("compact-restart", 0, "Only merge the restart files given by --restart into a full restart file", tools::Args::No, false);
+#ifdef WRITENETCDF
+	args.addOption("chunk-size", 0, "Chunk shape of the netCDF output as time,y,x (0 = whole dimension, chosen by the library if not set)", tools::Args::Required, false);
+	args.addOption("deflate", 0, "Deflate level of the netCDF output (0-9, default 0)", tools::Args::Required, false);
+	args.addOption("shuffle", 0, "Shuffle the netCDF output before deflating", tools::Args::No, false);
+	args.addOption("significant-digits", 0, "Significant decimal digits kept in the netCDF output (lossy, default all)", tools::Args::Required, false);
+	args.addOption("io-report", 0, "Print throughput and compression ratio of every snapshot", tools::Args::No, false);
+	args.addOption("envelope", 0, "Write the maximum wave height, maximum speed and arrival time at the end (not with --restart)", tools::Args::No, false);
+	args.addOption("arrival-threshold", 0, "Deviation of the surface elevation which marks the arrival of the wave (default 0.01)", tools::Args::Required, false);
+#endif
+#ifdef ASYNC_WRITER
+	args.addOption("writer-queue", 'q', "Number of snapshots queued for the output thread, 0 writes synchronously (default 2)", tools::Args::Required, false);
+#endif
+#ifdef STREAM_OUTPUT
+	args.addOption("stream-engine", 0, "Engine of the output stream: file (default), socket or shm", tools::Args::Required, false);
+#endif
+#ifdef NETCDF_PARALLEL
+	args.addOption("single-file", 'f', "Write the output of all ranks into one netCDF file", tools::Args::No, false);
+	args.addOption("collective-buffering", 'c', "Collective buffering for the single file: enable, disable or automatic (default)", tools::Args::Required, false);
+#endif
+#ifdef AMPI
+	args.addOption("migration-interval", 'm', "Number of checkpoints between two load balancing steps, 0 disables migration (default 1)", tools::Args::Required, false);
+#endif
 
 
 	// Declare the variables needed to hold command line input
@@ -82,10 +133,41 @@ int main(int argc, char** argv) {
 	int nxRequested;
 	int nyRequested;
 	std::string outputBaseName;
+	unsigned int outputInterval;
+	std::string outputRegionList;
+	std::vector<Writer::Field> outputFields;
+	std::string gaugeFileName;
+	unsigned int gaugeFlushInterval;
+	std::string restartName;
+	unsigned int restartInterval;
+	unsigned int restartFullInterval;
+#ifdef STREAM_OUTPUT
+	std::string streamEngine;
+#endif
+#ifdef READNETCDF
+	SWE_NetCdfScenario::Resampling resampling;
+#endif
+#ifdef WRITENETCDF
+	NetCdfWriter::Options netCdfOptions;
+	bool envelope;
+	float arrivalThreshold;
+#endif
+#ifdef ASYNC_WRITER
+	int writerQueueDepth;
+#endif
+#ifdef NETCDF_PARALLEL
+	bool singleFile;
+	std::string collectiveBuffering;
+#endif
+#ifdef AMPI
+	int migrationInterval;
+#endif
 
 	// Declare variables for the output and the simulation time
 	std::string outputFileName;
 	float t = 0.;
+	unsigned int iterations = 0;
+	int firstCheckPoint = 0;
 
 	// Parse command line arguments
 	tools::Args::Result ret = args.parse(argc, argv);
@@ -105,12 +187,98 @@ int main(int argc, char** argv) {
 	nxRequested = args.getArgument<int>("resolution-horizontal");
 	nyRequested = args.getArgument<int>("resolution-vertical");
 	outputBaseName = args.getArgument<std::string>("output-basepath");
+	outputInterval = args.getArgument<unsigned int>("output-interval", 1);
+	outputRegionList = args.getArgument<std::string>("output-region", "");
+	gaugeFileName = args.getArgument<std::string>("gauges", "");
+	gaugeFlushInterval = args.getArgument<unsigned int>("gauge-flush", 100);
+	restartName = args.getArgument<std::string>("restart", "");
+	restartInterval = args.getArgument<unsigned int>("restart-interval", 0);
+	restartFullInterval = args.getArgument<unsigned int>("restart-full-interval", 1);
+	if (args.isSet("compact-restart") && restartName.empty()) {
+		std::cerr << "Compacting requires the restart files (--restart)" << std::endl;
+		return 1;
+	}
+	// The writers would truncate the output of the earlier run
+	if (!restartName.empty() && restartName == outputBaseName && !args.isSet("compact-restart")) {
+		std::cerr << "A restarted run needs a new output base name (--output-basepath)" << std::endl;
+		return 1;
+	}
+	if (!Writer::parseFields(args.getArgument<std::string>("output-fields", "h,hu,hv"), outputFields)) {
+		std::cerr << "Unknown output field in " << args.getArgument<std::string>("output-fields") << std::endl;
+		return 1;
+	}
+#ifdef WRITENETCDF
+	if (args.isSet("chunk-size")) {
+		netCdfOptions.chunked = true;
+		sscanf(args.getArgument<std::string>("chunk-size").c_str(), "%u,%u,%u",
+				&netCdfOptions.chunkTime, &netCdfOptions.chunkY, &netCdfOptions.chunkX);
+	}
+	netCdfOptions.deflateLevel = args.getArgument<int>("deflate", 0);
+	netCdfOptions.shuffle = args.isSet("shuffle");
+	netCdfOptions.significantDigits = args.getArgument<int>("significant-digits", 0);
+	netCdfOptions.report = args.isSet("io-report");
+	envelope = args.isSet("envelope");
+	arrivalThreshold = args.getArgument<float>("arrival-threshold", .01f);
+	// The restart files do not contain the envelope of the earlier run
+	if (envelope && !restartName.empty()) {
+		std::cerr << "The envelope can not be continued after a restart" << std::endl;
+		return 1;
+	}
+#endif
+#ifdef ASYNC_WRITER
+	writerQueueDepth = args.getArgument<int>("writer-queue", 2);
+#endif
+#ifdef READNETCDF
+	if (!SWE_NetCdfScenario::parseResampling(args.getArgument<std::string>("resampling", "nearest"), resampling)) {
+		std::cerr << "Unknown resampling: " << args.getArgument<std::string>("resampling") << std::endl;
+		return 1;
+	}
+#endif
+#ifdef STREAM_OUTPUT
+	streamEngine = args.getArgument<std::string>("stream-engine", "file");
+	if (streamEngine != "file" && streamEngine != "socket" && streamEngine != "shm") {
+		std::cerr << "Unknown stream engine: " << streamEngine << std::endl;
+		return 1;
+	}
+#endif
+#ifdef NETCDF_PARALLEL
+	singleFile = args.isSet("single-file");
+	collectiveBuffering = args.getArgument<std::string>("collective-buffering", "automatic");
+#endif
+#ifdef AMPI
+	migrationInterval = args.getArgument<int>("migration-interval", 1);
+#if defined(WRITENETCDF) && defined(NETCDF_PARALLEL)
+	// A shared file can not be closed by a single migrating rank
+	if (singleFile)
+		migrationInterval = 0;
+#endif
+#endif
 
-	// Initialize scenario
-#ifdef ASAGI
-	SWE_AsagiScenario scenario(args.getArgument<std::string>("bathymetry-file"), args.getArgument<std::string>("displacement-file"));
+	// Initialize scenario, a restarted run reads the state from the restart files instead
+#ifdef DYNAMIC_DISPLACEMENTS
+	// The sea floor may still move after the restart
+	const bool initialState = !args.isSet("compact-restart");
 #else
-	SWE_RadialDamBreakScenario scenario;
+	const bool initialState = restartName.empty();
+#endif
+#if defined(ASAGI)
+	SWE_AsagiScenario *initialScenario = initialState ? new SWE_AsagiScenario(args.getArgument<std::string>("bathymetry-file"), args.getArgument<std::string>("displacement-file")) : 0;
+#elif defined(READNETCDF)
+	SWE_NetCdfScenario *initialScenario = initialState ? new SWE_NetCdfScenario(args.getArgument<std::string>("bathymetry-file"), args.getArgument<std::string>("displacement-file")) : 0;
+	// Inputs larger than the memory are read tile by tile
+	if (initialScenario && args.isSet("input-cache"))
+		initialScenario->stream(args.getArgument<size_t>("input-cache") * 1024 * 1024);
+	if (initialScenario)
+		initialScenario->setResampling(resampling);
+#else
+	SWE_RadialDamBreakScenario *initialScenario = initialState ? new SWE_RadialDamBreakScenario : 0;
+#endif
+#if defined(ASAGI) || defined(READNETCDF)
+	const std::string bathymetryCacheName = args.getArgument<std::string>("bathymetry-cache", "");
+	if (args.isSet("preprocess") && bathymetryCacheName.empty()) {
+		std::cerr << "Preprocessing requires a bathymetry cache" << std::endl;
+		return 1;
+	}
 #endif
 
 	// Compute when (w.r.t. to the simulation time in seconds) the checkpoints are reached
@@ -129,17 +297,6 @@ int main(int argc, char** argv) {
 	 **********************************/
 
 
-	/*
-	 * Calculate the cell widths of the grid used by the simulation:
-	 * Get the size of the actual domain and divide it by the requested resolution.
-	 *
-	 * We use simple scenarios for testing, so we assume the position of BND_BOTTOM and BND_LEFT are at 0 respectively
-	 */
-	int widthScenario = scenario.getBoundaryPos(BND_RIGHT) - scenario.getBoundaryPos(BND_LEFT);
-	int heightScenario = scenario.getBoundaryPos(BND_TOP) - scenario.getBoundaryPos(BND_BOTTOM);
-	float dxSimulation = (float) widthScenario / nxRequested;
-	float dySimulation = (float) heightScenario/ nyRequested;
-
 	// initialize MPI
 	if (MPI_Init(&argc, &argv) != MPI_SUCCESS) {
 		std::cerr << "MPI_Init failed." << std::endl;
@@ -156,6 +313,30 @@ int main(int argc, char** argv) {
 
 	printf("%i Spawned at %s\n", myMpiRank, hostname);
 
+#if defined(ASAGI) || defined(READNETCDF)
+	if (args.isSet("build-pyramid")) {
+		// Coarse simulations read the bathymetry from these copies, the first rank builds them
+		int built = (myMpiRank == 0)
+				&& InputPyramid::build(args.getArgument<std::string>("bathymetry-file"), args.getArgument<int>("build-pyramid"));
+		MPI_Bcast(&built, 1, MPI_INT, 0, MPI_COMM_WORLD);
+		MPI_Finalize();
+		return built ? 0 : 1;
+	}
+#endif
+
+#if defined(READNETCDF) && !defined(AMPI)
+	// Migrating ranks can not keep memory shared within a node
+	if (initialScenario && args.isSet("share-input"))
+		initialScenario->shareNode(MPI_COMM_WORLD);
+#endif
+
+#ifdef AMPI
+	// Ranks are migrated at (some) checkpoints, the runtime decides where each rank goes
+	MPI_Info migrationHints;
+	MPI_Info_create(&migrationHints);
+	MPI_Info_set(migrationHints, "ampi_load_balance", "sync");
+#endif
+
 	/*
 	 * determine the layout of UPC++ ranks:
 	 * one block per process;
@@ -182,23 +363,137 @@ int main(int argc, char** argv) {
 	int nxLocal = (localBlockPositionX < blockCountX - 1) ? nxBlockSimulation : nxRemainderSimulation;
 	int nyLocal = (localBlockPositionY < blockCountY - 1) ? nyBlockSimulation : nyRemainderSimulation;
 
+	if (args.isSet("compact-restart")) {
+		// Every rank merges the files of its block
+		int compacted = RestartFile(generateBaseFileName(restartName, localBlockPositionX, localBlockPositionY) + "_restart").compact();
+		MPI_Allreduce(MPI_IN_PLACE, &compacted, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+		MPI_Finalize();
+		return compacted ? 0 : 1;
+	}
+
+	// Domain and boundaries of the simulation
+	SWE_Scenario *scenario = initialScenario;
+	if (!restartName.empty()) {
+		RestartFile::Header restartHeader;
+		int found = RestartFile(generateBaseFileName(restartName, localBlockPositionX, localBlockPositionY) + "_restart").readHeader(restartHeader);
+		MPI_Allreduce(MPI_IN_PLACE, &found, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+		if (!found) {
+			if (myMpiRank == 0)
+				std::cerr << "Could not restart from " << restartName << " with " << totalMpiRanks << " ranks" << std::endl;
+			MPI_Finalize();
+			return 1;
+		}
+		scenario = new SWE_RestartScenario(restartHeader);
+	}
+
+	/*
+	 * Calculate the cell widths of the grid used by the simulation:
+	 * Get the size of the actual domain and divide it by the requested resolution.
+	 *
+	 * We use simple scenarios for testing, so we assume the position of BND_BOTTOM and BND_LEFT are at 0 respectively
+	 */
+	int widthScenario = scenario->getBoundaryPos(BND_RIGHT) - scenario->getBoundaryPos(BND_LEFT);
+	int heightScenario = scenario->getBoundaryPos(BND_TOP) - scenario->getBoundaryPos(BND_BOTTOM);
+	float dxSimulation = (float) widthScenario / nxRequested;
+	float dySimulation = (float) heightScenario/ nyRequested;
+#if defined(ASAGI) || defined(READNETCDF)
+	// Coarse simulations do not need the full resolution of the bathymetry
+	if (restartName.empty())
+		initialScenario->selectResolution(dxSimulation, dySimulation);
+#endif
+
 	// Compute the origin of the local simulation block w.r.t. the original scenario domain.
-	float localOriginX = scenario.getBoundaryPos(BND_LEFT) + localBlockPositionX * dxSimulation * nxBlockSimulation;
-	float localOriginY = scenario.getBoundaryPos(BND_BOTTOM) + localBlockPositionY * dySimulation * nyBlockSimulation;
+	float localOriginX = scenario->getBoundaryPos(BND_LEFT) + localBlockPositionX * dxSimulation * nxBlockSimulation;
+	float localOriginY = scenario->getBoundaryPos(BND_BOTTOM) + localBlockPositionY * dySimulation * nyBlockSimulation;
 
 	// Determine the boundary types for the SWE_Block:
 	// block boundaries bordering other blocks have a CONNECT boundary,
 	// block boundaries bordering the entire scenario have the respective scenario boundary type
 	BoundaryType boundaries[4];
 
-	boundaries[BND_LEFT] = (localBlockPositionX > 0) ? CONNECT : scenario.getBoundaryType(BND_LEFT);
-	boundaries[BND_RIGHT] = (localBlockPositionX < blockCountX - 1) ? CONNECT : scenario.getBoundaryType(BND_RIGHT);
-	boundaries[BND_BOTTOM] = (localBlockPositionY > 0) ? CONNECT : scenario.getBoundaryType(BND_BOTTOM);
-	boundaries[BND_TOP] = (localBlockPositionY < blockCountY - 1) ? CONNECT : scenario.getBoundaryType(BND_TOP);
+	boundaries[BND_LEFT] = (localBlockPositionX > 0) ? CONNECT : scenario->getBoundaryType(BND_LEFT);
+	boundaries[BND_RIGHT] = (localBlockPositionX < blockCountX - 1) ? CONNECT : scenario->getBoundaryType(BND_RIGHT);
+	boundaries[BND_BOTTOM] = (localBlockPositionY > 0) ? CONNECT : scenario->getBoundaryType(BND_BOTTOM);
+	boundaries[BND_TOP] = (localBlockPositionY < blockCountY - 1) ? CONNECT : scenario->getBoundaryType(BND_TOP);
 
 	// Initialize the simulation block according to the scenario
 	SWE_DimensionalSplittingMpi simulation(nxLocal, nyLocal, dxSimulation, dySimulation, localOriginX, localOriginY);
-	simulation.initScenario(scenario, boundaries);
+	if (!restartName.empty()) {
+		// Every block restores its own state
+		RestartFile::Header restartHeader;
+		int restored = simulation.readRestart(
+				RestartFile(generateBaseFileName(restartName, localBlockPositionX, localBlockPositionY) + "_restart"),
+				boundaries, restartHeader)
+			&& restartHeader.blockPositionX == localBlockPositionX && restartHeader.blockPositionY == localBlockPositionY
+			&& restartHeader.blockCountX == blockCountX && restartHeader.blockCountY == blockCountY;
+		MPI_Allreduce(MPI_IN_PLACE, &restored, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+		if (!restored) {
+			if (myMpiRank == 0)
+				std::cerr << "Could not restart from " << restartName << " with " << totalMpiRanks << " ranks" << std::endl;
+			MPI_Finalize();
+			return 1;
+		}
+		t = restartHeader.time;
+		iterations = restartHeader.iteration;
+		firstCheckPoint = restartHeader.checkpoint;
+	}
+#if defined(ASAGI) || defined(READNETCDF)
+	// The bathymetry may have been sampled on this grid from the same input by an earlier run
+	BathymetryCache bathymetryCache(bathymetryCacheName,
+			initialScenario ? initialScenario->getBathymetryFilename() : std::string(),
+#ifdef READNETCDF
+			resampling,
+#else
+			0,
+#endif
+			nxRequested, nyRequested,
+			scenario->getBoundaryPos(BND_LEFT), scenario->getBoundaryPos(BND_BOTTOM),
+			dxSimulation, dySimulation);
+	int bathymetryCached = !bathymetryCacheName.empty() && bathymetryCache.map();
+	// All ranks have to take the same path
+	MPI_Allreduce(MPI_IN_PLACE, &bathymetryCached, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+	if (!restartName.empty()) {
+		// The bathymetry is part of the restored state
+	} else if (bathymetryCached) {
+#ifdef READNETCDF
+		initialScenario->loadDisplacement(localOriginX, localOriginX + nxLocal * dxSimulation,
+				localOriginY, localOriginY + nyLocal * dySimulation, 2
+#ifdef NETCDF_PARALLEL
+				, MPI_COMM_WORLD
+#endif
+				);
+#endif
+		simulation.initScenario(*initialScenario, boundaries, bathymetryCache,
+				localBlockPositionX * nxBlockSimulation, localBlockPositionY * nyBlockSimulation);
+	} else {
+#ifdef READNETCDF
+		// Only the part of the input covering this block is read
+		initialScenario->loadRegion(localOriginX, localOriginX + nxLocal * dxSimulation,
+				localOriginY, localOriginY + nyLocal * dySimulation, 2
+#ifdef NETCDF_PARALLEL
+				, MPI_COMM_WORLD
+#endif
+				);
+#endif
+		simulation.initScenario(*initialScenario, boundaries);
+		if (!bathymetryCacheName.empty()) {
+			simulation.storeBathymetry(*initialScenario, bathymetryCache,
+					localBlockPositionX * nxBlockSimulation, localBlockPositionY * nyBlockSimulation);
+			bathymetryCache.flush();
+			// The cache becomes valid once all blocks are stored
+			MPI_Barrier(MPI_COMM_WORLD);
+			if (myMpiRank == 0)
+				bathymetryCache.commit();
+		}
+	}
+	if (args.isSet("preprocess")) {
+		MPI_Finalize();
+		return 0;
+	}
+#else
+	if (restartName.empty())
+		simulation.initScenario(*initialScenario, boundaries);
+#endif
 
 	// calculate neighbours to the current ranks simulation block
 	int myNeighbours[4];
@@ -219,9 +514,50 @@ int main(int argc, char** argv) {
 	// Initialize boundary size of the ghost layers
 	BoundarySize boundarySize = {{1, 1, 1, 1}};
 	outputFileName = generateBaseFileName(outputBaseName, localBlockPositionX, localBlockPositionY);
-#ifdef WRITENETCDF
+#if defined(STREAM_OUTPUT)
+	// Construct a stream writer
+	StreamWriter *writer = new StreamWriter(
+			outputFileName,
+			simulation.getBathymetry(),
+			boundarySize,
+			nxLocal,
+			nyLocal,
+			dxSimulation,
+			dySimulation,
+			simulation.getOriginX(),
+			simulation.getOriginY(),
+			StreamEngine::create(streamEngine, outputFileName));
+#elif defined(WRITENETCDF)
+	NetCdfWriter *writer;
+#ifdef NETCDF_PARALLEL
+	if (singleFile) {
+		// Construct a netCDF writer for one file shared by all ranks
+		MPI_Info ioHints;
+		MPI_Info_create(&ioHints);
+		MPI_Info_set(ioHints, "romio_cb_write", collectiveBuffering.c_str());
+		writer = new NetCdfWriter(
+				outputBaseName,
+				simulation.getBathymetry(),
+				boundarySize,
+				nxLocal,
+				nyLocal,
+				dxSimulation,
+				dySimulation,
+				simulation.getOriginX(),
+				simulation.getOriginY(),
+				nxRequested,
+				nyRequested,
+				localBlockPositionX * nxBlockSimulation,
+				localBlockPositionY * nyBlockSimulation,
+				MPI_COMM_WORLD,
+				ioHints,
+				0,
+				netCdfOptions);
+		MPI_Info_free(&ioHints);
+	} else
+#endif // NETCDF_PARALLEL
 	// Construct a netCDF writer
-	NetCdfWriter writer(
+	writer = new NetCdfWriter(
 			outputFileName,
 			simulation.getBathymetry(),
 			boundarySize,
@@ -230,25 +566,173 @@ int main(int argc, char** argv) {
 			dxSimulation,
 			dySimulation,
 			simulation.getOriginX(),
-			simulation.getOriginY());
+			simulation.getOriginY(),
+			0,
+			netCdfOptions);
 #else
 	// Construct a vtk writer
-	VtkWriter writer(
+	VtkWriter *writer = new VtkWriter(
 			outputFileName,
 			simulation.getBathymetry(),
 			boundarySize,
 			nxLocal,
 			nyLocal,
 			dxSimulation,
-			dySimulation);
+			dySimulation,
+			localBlockPositionX * nxBlockSimulation,
+			localBlockPositionY * nyBlockSimulation);
+
+	// The first rank combines the blocks of each time step in a ParaView-Container-File
+	if (myMpiRank == 0 && blockCountX * blockCountY > 1) {
+		writer->setContainerBaseName(outputBaseName);
+		for (int x = 0; x < blockCountX; x++) {
+			for (int y = 0; y < blockCountY; y++) {
+				writer->addContainerPiece(
+						generateBaseFileName(outputBaseName, x, y),
+						x * nxBlockSimulation,
+						y * nyBlockSimulation,
+						(x < blockCountX - 1) ? nxBlockSimulation : nxRemainderSimulation,
+						(y < blockCountY - 1) ? nyBlockSimulation : nyRemainderSimulation);
+			}
+		}
+	}
 #endif // WRITENETCDF
 
-	// Write the output at t = 0
-	writer.writeTimeStep(
-			simulation.getWaterHeight(),
-			simulation.getMomentumHorizontal(),
-			simulation.getMomentumVertical(),
-			(float) 0.);
+#ifdef WRITENETCDF
+	// The envelope is accumulated while the unknowns are updated
+	if (envelope)
+		simulation.enableEnvelope(arrivalThreshold, t);
+#endif
+
+	// Only the selected (possibly derived) fields are written
+	writer->setFields(outputFields);
+
+	// All snapshots go through output, which may hand them to a background thread
+	Writer *output = writer;
+#ifdef ASYNC_WRITER
+#ifdef NETCDF_PARALLEL
+	// Only the main thread may call MPI
+	if (singleFile)
+		writerQueueDepth = 0;
+#endif
+	if (writerQueueDepth > 0)
+		output = new AsyncWriter(*output, writerQueueDepth);
+#endif
+
+	// Additional writers for regions of interest, possibly with a coarser resolution
+	std::vector<OutputRegion> outputRegions;
+	if (!OutputRegion::parse(outputRegionList,
+			scenario->getBoundaryPos(BND_LEFT), scenario->getBoundaryPos(BND_BOTTOM),
+			dxSimulation, dySimulation,
+			localBlockPositionX * nxBlockSimulation, localBlockPositionY * nyBlockSimulation,
+			nxLocal, nyLocal,
+			outputRegions)) {
+		std::cerr << "Invalid output region: " << outputRegionList << std::endl;
+		MPI_Finalize();
+		return 1;
+	}
+#ifdef WRITENETCDF
+	// Closed and reopened with the main writer during migrations
+	std::vector<NetCdfWriter*> regionWriters(outputRegions.size());
+#else
+	std::vector<Writer*> regionWriters(outputRegions.size());
+#endif
+	for (size_t r = 0; r < outputRegions.size(); r++) {
+		const OutputRegion &region = outputRegions[r];
+		// This block does not contribute to the region
+		if (region.isEmpty())
+			continue;
+
+		std::ostringstream regionFileName;
+		regionFileName << outputFileName << "_region" << r;
+#if defined(STREAM_OUTPUT) || defined(WRITENETCDF)
+		const float regionOriginX = simulation.getOriginX() + region.firstX * dxSimulation;
+		const float regionOriginY = simulation.getOriginY() + region.firstY * dySimulation;
+#endif
+#if defined(STREAM_OUTPUT)
+		regionWriters[r] = new StreamWriter(
+				regionFileName.str(),
+				simulation.getBathymetry(),
+				boundarySize,
+				region.getNX(),
+				region.getNY(),
+				dxSimulation * region.strideX,
+				dySimulation * region.strideY,
+				regionOriginX,
+				regionOriginY,
+				StreamEngine::create(streamEngine, regionFileName.str()));
+#elif defined(WRITENETCDF)
+		regionWriters[r] = new NetCdfWriter(
+				regionFileName.str(),
+				simulation.getBathymetry(),
+				boundarySize,
+				region.getNX(),
+				region.getNY(),
+				dxSimulation * region.strideX,
+				dySimulation * region.strideY,
+				regionOriginX,
+				regionOriginY,
+				0,
+				netCdfOptions);
+#else
+		regionWriters[r] = new VtkWriter(
+				regionFileName.str(),
+				simulation.getBathymetry(),
+				boundarySize,
+				region.getNX(),
+				region.getNY(),
+				dxSimulation * region.strideX,
+				dySimulation * region.strideY,
+				region.offsetX,
+				region.offsetY,
+				region.domainFirstX * dxSimulation,
+				region.domainFirstY * dySimulation);
+#endif
+		regionWriters[r]->setRegion(region);
+		regionWriters[r]->setFields(outputFields);
+	}
+
+	// Time series at gauge locations, all ranks write to one table
+	GaugeWriter *gaugeWriter = 0;
+	if (!gaugeFileName.empty()) {
+		std::vector<GaugeWriter::Gauge> gauges;
+		if (!GaugeWriter::readGauges(gaugeFileName, gauges)) {
+			std::cerr << "Could not read gauges from " << gaugeFileName << std::endl;
+			MPI_Finalize();
+			return 1;
+		}
+		gaugeWriter = new GaugeWriter(
+				outputBaseName + "_gauges.txt",
+				gauges,
+				boundarySize,
+				scenario->getBoundaryPos(BND_LEFT), scenario->getBoundaryPos(BND_BOTTOM),
+				dxSimulation, dySimulation,
+				localBlockPositionX * nxBlockSimulation, localBlockPositionY * nyBlockSimulation,
+				nxLocal, nyLocal,
+				gaugeFlushInterval);
+	}
+
+	// Write the output at t = 0 (or at the time of the restart)
+	if (outputInterval > 0)
+		output->writeTimeStep(
+				simulation.getWaterHeight(),
+				simulation.getMomentumHorizontal(),
+				simulation.getMomentumVertical(),
+				t);
+	for (size_t r = 0; r < regionWriters.size(); r++) {
+		if (regionWriters[r])
+			regionWriters[r]->writeTimeStep(
+					simulation.getWaterHeight(),
+					simulation.getMomentumHorizontal(),
+					simulation.getMomentumVertical(),
+					t);
+	}
+	if (gaugeWriter)
+		gaugeWriter->record(
+				simulation.getWaterHeight(),
+				simulation.getMomentumHorizontal(),
+				simulation.getMomentumVertical(),
+				t);
 
 
 	/********************
@@ -262,12 +746,12 @@ int main(int argc, char** argv) {
 
 	float wallTime = 0.;
 
-	t = 0.0;
+	// Restart files, possibly only with the changes since the previous one
+	RestartFile restartFile(outputFileName + "_restart", restartFullInterval);
 
 	float timestep;
-	unsigned int iterations = 0;
 	// loop over the count of requested checkpoints
-	for(int i = 0; i < numberOfCheckPoints; i++) {
+	for(int i = firstCheckPoint; i < numberOfCheckPoints; i++) {
 		// Simulate until the checkpoint is reached
 		while(t < checkpointInstantOfTime[i]) {
 			// Start measurement
@@ -294,6 +778,19 @@ int main(int argc, char** argv) {
 			// update simulation time with time step width.
 			t += timestep;
 			iterations++;
+
+			// move the sea floor if the scenario has a time-dependent displacement,
+			// the bathymetry of the ghost layers is only exchanged while it changes
+			if (initialScenario && simulation.updateDisplacement(*initialScenario, t))
+				simulation.exchangeBathymetry();
+
+			// the gauges are recorded after every time step
+			if (gaugeWriter)
+				gaugeWriter->record(
+						simulation.getWaterHeight(),
+						simulation.getMomentumHorizontal(),
+						simulation.getMomentumVertical(),
+						t);
 			MPI_Barrier(MPI_COMM_WORLD);
 		}
 
@@ -302,11 +799,57 @@ int main(int argc, char** argv) {
 		}
 
 		// write output
-		writer.writeTimeStep(
-				simulation.getWaterHeight(),
-				simulation.getMomentumHorizontal(),
-				simulation.getMomentumVertical(),
-				t);
+		if (outputInterval > 0 && (i + 1) % outputInterval == 0)
+			output->writeTimeStep(
+					simulation.getWaterHeight(),
+					simulation.getMomentumHorizontal(),
+					simulation.getMomentumVertical(),
+					t);
+		for (size_t r = 0; r < regionWriters.size(); r++) {
+			if (regionWriters[r] && (i + 1) % outputRegions[r].interval == 0)
+				regionWriters[r]->writeTimeStep(
+						simulation.getWaterHeight(),
+						simulation.getMomentumHorizontal(),
+						simulation.getMomentumVertical(),
+						t);
+		}
+
+		// write the complete state, every block writes its own file
+		if (restartInterval > 0 && (i + 1) % restartInterval == 0) {
+			RestartFile::Header restartHeader = RestartFile::Header();
+			restartHeader.blockPositionX = localBlockPositionX;
+			restartHeader.blockPositionY = localBlockPositionY;
+			restartHeader.blockCountX = blockCountX;
+			restartHeader.blockCountY = blockCountY;
+			restartHeader.checkpoint = i + 1;
+			restartHeader.iteration = iterations;
+			restartHeader.time = t;
+			SWE_RestartScenario::storeDomain(*scenario, restartHeader);
+			simulation.writeRestart(restartFile, restartHeader);
+		}
+
+#ifdef AMPI
+		// Let the runtime balance the virtual ranks, the whole heap and stack of a rank is migrated (isomalloc).
+		// Only the open output file has to be closed before.
+		if (migrationInterval > 0 && (i + 1) % migrationInterval == 0 && i + 1 < numberOfCheckPoints) {
+#ifdef WRITENETCDF
+			writer->close();
+			for (size_t r = 0; r < regionWriters.size(); r++)
+				if (regionWriters[r])
+					regionWriters[r]->close();
+#endif
+			AMPI_Migrate(migrationHints);
+#ifdef WRITENETCDF
+			bool reopened = writer->reopen();
+			for (size_t r = 0; r < regionWriters.size(); r++)
+				if (regionWriters[r])
+					reopened = regionWriters[r]->reopen() && reopened;
+			// The output of this rank is lost, do not continue without it
+			if (!reopened)
+				MPI_Abort(MPI_COMM_WORLD, 1);
+#endif
+		}
+#endif
 	}
 
 
@@ -314,9 +857,32 @@ int main(int argc, char** argv) {
 	 * FINALIZE *
 	 ************/
 
+#ifdef ASYNC_WRITER
+	// Writes the queued snapshots
+	if (output != writer)
+		delete output;
+#endif
+#ifdef WRITENETCDF
+	if (simulation.hasEnvelope())
+		writer->writeEnvelope(simulation.getMaxWaveHeight(), simulation.getMaxSpeed(), simulation.getArrivalTime());
+#endif
+	for (size_t r = 0; r < regionWriters.size(); r++)
+		delete regionWriters[r];
+	// Writes the remaining gauge records
+	delete gaugeWriter;
+	if (scenario != initialScenario)
+		delete scenario;
+	delete initialScenario;
+
 	printf("Rank %i : Compute Time (CPU): %fs - (WALL): %fs | Total Time (Wall): %fs\n", myMpiRank, simulation.computeTime, simulation.computeTimeWall, wallTime); 
 
+	// Closes the output file (collectively for a shared file)
+	delete writer;
+
 	simulation.freeMpiType();
+#ifdef AMPI
+	MPI_Info_free(&migrationHints);
+#endif
 	MPI_Finalize();
 
 	return 0;
@@ -32,20 +32,30 @@
 #include <time.h>
 #include <unistd.h>
 #include <limits.h>
+#include <vector>
 
 #include "tools/args.hh"
 
-#ifdef WRITENETCDF
+#if defined(STREAM_OUTPUT)
+#include "writer/StreamWriter.hh"
+#elif defined(WRITENETCDF)
 #include "writer/NetCdfWriter.hh"
 #else
 #include "writer/VtkWriter.hh"
 #endif
+#ifdef ASYNC_WRITER
+#include "writer/AsyncWriter.hh"
+#endif
+#include "writer/GaugeWriter.hh"
 
-#ifdef ASAGI
+#if defined(ASAGI)
 #include "scenarios/SWE_AsagiScenario.hh"
+#elif defined(READNETCDF)
+#include "scenarios/SWE_NetCdfScenario.hh"
 #else
 #include "scenarios/SWE_simple_scenarios.hh"
 #endif
+#include "scenarios/SWE_RestartScenario.hh"
 
 #include "blocks/SWE_DimensionalSplitting.hh"
 
@@ -61,15 +71,46 @@ int main(int argc, char** argv) {
 	// Define command line arguments
 	tools::Args args;
 
-#ifdef ASAGI
+#if defined(ASAGI) || defined(READNETCDF)
 	args.addOption("bathymetry-file", 'b', "File containing the bathymetry");
 	args.addOption("displacement-file", 'd', "File containing the displacement");
+	args.addOption("bathymetry-cache", 0, "Binary file with the bathymetry sampled on the simulation grid, created if it does not match (one file per bathymetry)", tools::Args::Required, false);
+	args.addOption("preprocess", 0, "Only create the bathymetry cache", tools::Args::No, false);
+	args.addOption("build-pyramid", 0, "Only build this many coarsened copies of the bathymetry, each with half the resolution of the previous one", tools::Args::Required, false);
+#endif
+#ifdef READNETCDF
+	args.addOption("input-cache", 0, "Stream the input in tiles, keeping at most this many MB of each input file in memory", tools::Args::Required, false);
+	args.addOption("resampling", 0, "Sampling of the input on the cells: nearest, bilinear or conservative (default nearest)", tools::Args::Required, false);
 #endif
 	args.addOption("simulation-duration", 't', "Time in seconds to simulate");
 	args.addOption("checkpoint-count", 'n', "Number of simulation snapshots to be written");
 	args.addOption("resolution-horizontal", 'x', "Number of simulation cells in horizontal direction");
 	args.addOption("resolution-vertical", 'y', "Number of simulated cells in y-direction");
 	args.addOption("output-basepath", 'o', "Output base file name");
+	args.addOption("output-interval", 0, "Write the full output every n-th checkpoint, 0 disables it (default 1)", tools::Args::Required, false);
+	args.addOption("output-region", 0, "Additional outputs xmin,xmax,ymin,ymax[,stride[,interval]], separated by ';'", tools::Args::Required, false);
+	args.addOption("output-fields", 0, "Written fields out of h,hu,hv,eta,speed,froude (default h,hu,hv)", tools::Args::Required, false);
+	args.addOption("gauges", 0, "File with gauge locations (one \"x y\" per line) recorded after every time step", tools::Args::Required, false);
+	args.addOption("gauge-flush", 0, "Number of time steps buffered before the gauges are written (default 100)", tools::Args::Required, false);
+	args.addOption("restart", 0, "Resume from the restart file of an earlier run with this output base name", tools::Args::Required, false);
+	args.addOption("restart-interval", 0, "Write a restart file every n-th checkpoint, 0 disables it (default 0)", tools::Args::Required, false);
+	args.addOption("restart-full-interval", 0, "Every n-th restart file contains the complete state, the others only the tiles changed since the previous one (default 1)", tools::Args::Required, false);
+	args.addOption("compact-restart", 0, "Only merge the restart files given by --restart into a full restart file", tools::Args::No, false);
+#ifdef WRITENETCDF
+	args.addOption("chunk-size", 0, "Chunk shape of the netCDF output as time,y,x (0 = whole dimension, chosen by the library if not set)", tools::Args::Required, false);
+	args.addOption("deflate", 0, "Deflate level of the netCDF output (0-9, default 0)", tools::Args::Required, false);
+	args.addOption("shuffle", 0, "Shuffle the netCDF output before deflating", tools::Args::No, false);
+	args.addOption("significant-digits", 0, "Significant decimal digits kept in the netCDF output (lossy, default all)", tools::Args::Required, false);
+	args.addOption("io-report", 0, "Print throughput and compression ratio of every snapshot", tools::Args::No, false);
+	args.addOption("envelope", 0, "Write the maximum wave height, maximum speed and arrival time at the end (not with --restart)", tools::Args::No, false);
+	args.addOption("arrival-threshold", 0, "Deviation of the surface elevation which marks the arrival of the wave (default 0.01)", tools::Args::Required, false);
+#endif
+#ifdef ASYNC_WRITER
+	args.addOption("writer-queue", 'q', "Number of snapshots queued for the output thread, 0 writes synchronously (default 2)", tools::Args::Required, false);
+#endif
+#ifdef STREAM_OUTPUT
+	args.addOption("stream-engine", 0, "Engine of the output stream: file (default), socket or shm", tools::Args::Required, false);
+#endif
 
 
 	// Declare the variables needed to hold command line input
@@ -78,10 +119,34 @@ int main(int argc, char** argv) {
 	int nxRequested;
 	int nyRequested;
 	std::string outputBaseName;
+	unsigned int outputInterval;
+	std::string outputRegionList;
+	std::vector<Writer::Field> outputFields;
+	std::string gaugeFileName;
+	unsigned int gaugeFlushInterval;
+	std::string restartName;
+	unsigned int restartInterval;
+	unsigned int restartFullInterval;
+#ifdef STREAM_OUTPUT
+	std::string streamEngine;
+#endif
+#ifdef READNETCDF
+	SWE_NetCdfScenario::Resampling resampling;
+#endif
+#ifdef WRITENETCDF
+	NetCdfWriter::Options netCdfOptions;
+	bool envelope;
+	float arrivalThreshold;
+#endif
+#ifdef ASYNC_WRITER
+	int writerQueueDepth;
+#endif
 
 	// Declare variables for the output and the simulation time
 	std::string outputFileName;
 	float t = 0.;
+	unsigned int iterations = 0;
+	int firstCheckPoint = 0;
 
 	// Parse command line arguments
 	tools::Args::Result ret = args.parse(argc, argv);
@@ -101,12 +166,103 @@ int main(int argc, char** argv) {
 	nxRequested = args.getArgument<int>("resolution-horizontal");
 	nyRequested = args.getArgument<int>("resolution-vertical");
 	outputBaseName = args.getArgument<std::string>("output-basepath");
+	outputInterval = args.getArgument<unsigned int>("output-interval", 1);
+	outputRegionList = args.getArgument<std::string>("output-region", "");
+	gaugeFileName = args.getArgument<std::string>("gauges", "");
+	gaugeFlushInterval = args.getArgument<unsigned int>("gauge-flush", 100);
+	restartName = args.getArgument<std::string>("restart", "");
+	restartInterval = args.getArgument<unsigned int>("restart-interval", 0);
+	restartFullInterval = args.getArgument<unsigned int>("restart-full-interval", 1);
+	if (args.isSet("compact-restart") && restartName.empty()) {
+		std::cerr << "Compacting requires the restart files (--restart)" << std::endl;
+		return 1;
+	}
+	// The writers would truncate the output of the earlier run
+	if (!restartName.empty() && restartName == outputBaseName && !args.isSet("compact-restart")) {
+		std::cerr << "A restarted run needs a new output base name (--output-basepath)" << std::endl;
+		return 1;
+	}
+	if (!Writer::parseFields(args.getArgument<std::string>("output-fields", "h,hu,hv"), outputFields)) {
+		std::cerr << "Unknown output field in " << args.getArgument<std::string>("output-fields") << std::endl;
+		return 1;
+	}
+#ifdef WRITENETCDF
+	if (args.isSet("chunk-size")) {
+		netCdfOptions.chunked = true;
+		sscanf(args.getArgument<std::string>("chunk-size").c_str(), "%u,%u,%u",
+				&netCdfOptions.chunkTime, &netCdfOptions.chunkY, &netCdfOptions.chunkX);
+	}
+	netCdfOptions.deflateLevel = args.getArgument<int>("deflate", 0);
+	netCdfOptions.shuffle = args.isSet("shuffle");
+	netCdfOptions.significantDigits = args.getArgument<int>("significant-digits", 0);
+	netCdfOptions.report = args.isSet("io-report");
+	envelope = args.isSet("envelope");
+	arrivalThreshold = args.getArgument<float>("arrival-threshold", .01f);
+	// The restart files do not contain the envelope of the earlier run
+	if (envelope && !restartName.empty()) {
+		std::cerr << "The envelope can not be continued after a restart" << std::endl;
+		return 1;
+	}
+#endif
+#ifdef ASYNC_WRITER
+	writerQueueDepth = args.getArgument<int>("writer-queue", 2);
+#endif
+#ifdef READNETCDF
+	if (!SWE_NetCdfScenario::parseResampling(args.getArgument<std::string>("resampling", "nearest"), resampling)) {
+		std::cerr << "Unknown resampling: " << args.getArgument<std::string>("resampling") << std::endl;
+		return 1;
+	}
+#endif
+#ifdef STREAM_OUTPUT
+	streamEngine = args.getArgument<std::string>("stream-engine", "file");
+	if (streamEngine != "file" && streamEngine != "socket" && streamEngine != "shm") {
+		std::cerr << "Unknown stream engine: " << streamEngine << std::endl;
+		return 1;
+	}
+#endif
+
+#if defined(ASAGI) || defined(READNETCDF)
+	// Coarse simulations read the bathymetry from these copies
+	if (args.isSet("build-pyramid"))
+		return InputPyramid::build(args.getArgument<std::string>("bathymetry-file"), args.getArgument<int>("build-pyramid")) ? 0 : 1;
+#endif
 
-	// Initialize Scenario
-#ifdef ASAGI
-	SWE_AsagiScenario scenario(args.getArgument<std::string>("bathymetry-file"), args.getArgument<std::string>("displacement-file"));
+	if (args.isSet("compact-restart"))
+		return RestartFile(restartName + "_restart").compact() ? 0 : 1;
+
+	// Initialize Scenario, a restarted run reads the state from the restart file instead
+#ifdef DYNAMIC_DISPLACEMENTS
+	// The sea floor may still move after the restart
+	const bool initialState = true;
+#else
+	const bool initialState = restartName.empty();
+#endif
+#if defined(ASAGI)
+	SWE_AsagiScenario *initialScenario = initialState ? new SWE_AsagiScenario(args.getArgument<std::string>("bathymetry-file"), args.getArgument<std::string>("displacement-file")) : 0;
+#elif defined(READNETCDF)
+	SWE_NetCdfScenario *initialScenario = initialState ? new SWE_NetCdfScenario(args.getArgument<std::string>("bathymetry-file"), args.getArgument<std::string>("displacement-file")) : 0;
+	// Inputs larger than the memory are read tile by tile
+	if (initialScenario && args.isSet("input-cache"))
+		initialScenario->stream(args.getArgument<size_t>("input-cache") * 1024 * 1024);
+	if (initialScenario)
+		initialScenario->setResampling(resampling);
 #else
-	SWE_RadialDamBreakScenario scenario;
+	SWE_RadialDamBreakScenario *initialScenario = initialState ? new SWE_RadialDamBreakScenario : 0;
+#endif
+	// Domain and boundaries of the simulation
+	SWE_Scenario *scenario = initialScenario;
+	if (!restartName.empty()) {
+		RestartFile::Header restartHeader;
+		if (!RestartFile(restartName + "_restart").readHeader(restartHeader))
+			return 1;
+		scenario = new SWE_RestartScenario(restartHeader);
+	}
+#if defined(ASAGI) || defined(READNETCDF)
+	const std::string bathymetryCacheName = args.getArgument<std::string>("bathymetry-cache", "");
+	if (args.isSet("preprocess") && bathymetryCacheName.empty()) {
+		std::cerr << "Preprocessing requires a bathymetry cache" << std::endl;
+		return 1;
+	}
 #endif
 
 	// Compute when (w.r.t. to the simulation time in seconds) the checkpoints are reached
@@ -130,22 +286,72 @@ int main(int argc, char** argv) {
 	 * The cell count of the scenario as well as the scenario size is fixed, 
 	 * Get the size of the actual domain and divide it by the requested resolution.
 	 */
-	int widthScenario = scenario.getBoundaryPos(BND_RIGHT) - scenario.getBoundaryPos(BND_LEFT);
-	int heightScenario = scenario.getBoundaryPos(BND_TOP) - scenario.getBoundaryPos(BND_BOTTOM);
+	int widthScenario = scenario->getBoundaryPos(BND_RIGHT) - scenario->getBoundaryPos(BND_LEFT);
+	int heightScenario = scenario->getBoundaryPos(BND_TOP) - scenario->getBoundaryPos(BND_BOTTOM);
 	float dxSimulation = (float) widthScenario / nxRequested;
 	float dySimulation = (float) heightScenario / nyRequested;
-	float originX = scenario.getBoundaryPos(BND_LEFT);
-	float originY = scenario.getBoundaryPos(BND_BOTTOM);
+	float originX = scenario->getBoundaryPos(BND_LEFT);
+	float originY = scenario->getBoundaryPos(BND_BOTTOM);
+#if defined(ASAGI) || defined(READNETCDF)
+	// Coarse simulations do not need the full resolution of the bathymetry
+	if (restartName.empty())
+		initialScenario->selectResolution(dxSimulation, dySimulation);
+#endif
 
 	BoundaryType boundaries[4];
 
-	boundaries[BND_LEFT] = scenario.getBoundaryType(BND_LEFT);
-	boundaries[BND_RIGHT] = scenario.getBoundaryType(BND_RIGHT);
-	boundaries[BND_BOTTOM] = scenario.getBoundaryType(BND_BOTTOM);
-	boundaries[BND_TOP] = scenario.getBoundaryType(BND_TOP);
+	boundaries[BND_LEFT] = scenario->getBoundaryType(BND_LEFT);
+	boundaries[BND_RIGHT] = scenario->getBoundaryType(BND_RIGHT);
+	boundaries[BND_BOTTOM] = scenario->getBoundaryType(BND_BOTTOM);
+	boundaries[BND_TOP] = scenario->getBoundaryType(BND_TOP);
 
 	SWE_DimensionalSplitting simulation(nxRequested, nyRequested, dxSimulation, dySimulation, originX, originY);
-	simulation.initScenario(scenario, boundaries);
+	if (!restartName.empty()) {
+		RestartFile::Header restartHeader;
+		if (!simulation.readRestart(RestartFile(restartName + "_restart"), boundaries, restartHeader))
+			return 1;
+		if (restartHeader.blockCountX != 1 || restartHeader.blockCountY != 1) {
+			std::cerr << "The restart file belongs to a decomposed domain" << std::endl;
+			return 1;
+		}
+		t = restartHeader.time;
+		iterations = restartHeader.iteration;
+		firstCheckPoint = restartHeader.checkpoint;
+	}
+#if defined(ASAGI) || defined(READNETCDF)
+	// The bathymetry may have been sampled on this grid from the same input by an earlier run
+	BathymetryCache bathymetryCache(bathymetryCacheName,
+			initialScenario ? initialScenario->getBathymetryFilename() : std::string(),
+#ifdef READNETCDF
+			resampling,
+#else
+			0,
+#endif
+			nxRequested, nyRequested, originX, originY, dxSimulation, dySimulation);
+	if (!restartName.empty()) {
+		// The bathymetry is part of the restored state
+	} else if (!bathymetryCacheName.empty() && bathymetryCache.map()) {
+#ifdef READNETCDF
+		initialScenario->loadDisplacement(originX, originX + nxRequested * dxSimulation, originY, originY + nyRequested * dySimulation);
+#endif
+		simulation.initScenario(*initialScenario, boundaries, bathymetryCache, 0, 0);
+	} else {
+#ifdef READNETCDF
+		initialScenario->loadRegion(originX, originX + nxRequested * dxSimulation, originY, originY + nyRequested * dySimulation);
+#endif
+		simulation.initScenario(*initialScenario, boundaries);
+		if (!bathymetryCacheName.empty()) {
+			simulation.storeBathymetry(*initialScenario, bathymetryCache, 0, 0);
+			bathymetryCache.flush();
+			bathymetryCache.commit();
+		}
+	}
+	if (args.isSet("preprocess"))
+		return 0;
+#else
+	if (restartName.empty())
+		simulation.initScenario(*initialScenario, boundaries);
+#endif
 
 
 	/***************
@@ -156,7 +362,20 @@ int main(int argc, char** argv) {
 	// Initialize boundary size of the ghost layers
 	BoundarySize boundarySize = {{1, 1, 1, 1}};
 	outputFileName = outputBaseName;
-#ifdef WRITENETCDF
+#if defined(STREAM_OUTPUT)
+	// Construct a stream writer
+	StreamWriter writer(
+			outputFileName,
+			simulation.getBathymetry(),
+			boundarySize,
+			nxRequested,
+			nyRequested,
+			dxSimulation,
+			dySimulation,
+			simulation.getOriginX(),
+			simulation.getOriginY(),
+			StreamEngine::create(streamEngine, outputFileName));
+#elif defined(WRITENETCDF)
 	// Construct a netCDF writer
 	NetCdfWriter writer(
 			outputFileName,
@@ -167,7 +386,9 @@ int main(int argc, char** argv) {
 			dxSimulation,
 			dySimulation,
 			simulation.getOriginX(),
-			simulation.getOriginY());
+			simulation.getOriginY(),
+			0,
+			netCdfOptions);
 #else
 	// Construct a vtk writer
 	VtkWriter writer(
@@ -180,12 +401,129 @@ int main(int argc, char** argv) {
 			dySimulation);
 #endif // WRITENETCDF
 
-	// Write the output at t = 0
-	writer.writeTimeStep(
-			simulation.getWaterHeight(),
-			simulation.getMomentumHorizontal(),
-			simulation.getMomentumVertical(),
-			(float) 0.);
+#ifdef WRITENETCDF
+	// The envelope is accumulated while the unknowns are updated
+	if (envelope)
+		simulation.enableEnvelope(arrivalThreshold, t);
+#endif
+
+	// Only the selected (possibly derived) fields are written
+	writer.setFields(outputFields);
+
+	// All snapshots go through output, which may hand them to a background thread
+	Writer *output = &writer;
+#ifdef ASYNC_WRITER
+	if (writerQueueDepth > 0)
+		output = new AsyncWriter(*output, writerQueueDepth);
+#endif
+
+	// Additional writers for regions of interest, possibly with a coarser resolution
+	std::vector<OutputRegion> outputRegions;
+	if (!OutputRegion::parse(outputRegionList,
+			originX, originY,
+			dxSimulation, dySimulation,
+			0, 0,
+			nxRequested, nyRequested,
+			outputRegions)) {
+		std::cerr << "Invalid output region: " << outputRegionList << std::endl;
+		return 1;
+	}
+	std::vector<Writer*> regionWriters(outputRegions.size());
+	for (size_t r = 0; r < outputRegions.size(); r++) {
+		const OutputRegion &region = outputRegions[r];
+		// This block does not contribute to the region
+		if (region.isEmpty())
+			continue;
+
+		std::ostringstream regionFileName;
+		regionFileName << outputFileName << "_region" << r;
+#if defined(STREAM_OUTPUT) || defined(WRITENETCDF)
+		const float regionOriginX = simulation.getOriginX() + region.firstX * dxSimulation;
+		const float regionOriginY = simulation.getOriginY() + region.firstY * dySimulation;
+#endif
+#if defined(STREAM_OUTPUT)
+		regionWriters[r] = new StreamWriter(
+				regionFileName.str(),
+				simulation.getBathymetry(),
+				boundarySize,
+				region.getNX(),
+				region.getNY(),
+				dxSimulation * region.strideX,
+				dySimulation * region.strideY,
+				regionOriginX,
+				regionOriginY,
+				StreamEngine::create(streamEngine, regionFileName.str()));
+#elif defined(WRITENETCDF)
+		regionWriters[r] = new NetCdfWriter(
+				regionFileName.str(),
+				simulation.getBathymetry(),
+				boundarySize,
+				region.getNX(),
+				region.getNY(),
+				dxSimulation * region.strideX,
+				dySimulation * region.strideY,
+				regionOriginX,
+				regionOriginY,
+				0,
+				netCdfOptions);
+#else
+		regionWriters[r] = new VtkWriter(
+				regionFileName.str(),
+				simulation.getBathymetry(),
+				boundarySize,
+				region.getNX(),
+				region.getNY(),
+				dxSimulation * region.strideX,
+				dySimulation * region.strideY,
+				region.offsetX,
+				region.offsetY,
+				region.domainFirstX * dxSimulation,
+				region.domainFirstY * dySimulation);
+#endif
+		regionWriters[r]->setRegion(region);
+		regionWriters[r]->setFields(outputFields);
+	}
+
+	// Time series at gauge locations
+	GaugeWriter *gaugeWriter = 0;
+	if (!gaugeFileName.empty()) {
+		std::vector<GaugeWriter::Gauge> gauges;
+		if (!GaugeWriter::readGauges(gaugeFileName, gauges)) {
+			std::cerr << "Could not read gauges from " << gaugeFileName << std::endl;
+			return 1;
+		}
+		gaugeWriter = new GaugeWriter(
+				outputBaseName + "_gauges.txt",
+				gauges,
+				boundarySize,
+				originX, originY,
+				dxSimulation, dySimulation,
+				0, 0,
+				nxRequested, nyRequested,
+				gaugeFlushInterval);
+	}
+
+	// Write the output at t = 0 (or at the time of the restart)
+	if (outputInterval > 0)
+		output->writeTimeStep(
+				simulation.getWaterHeight(),
+				simulation.getMomentumHorizontal(),
+				simulation.getMomentumVertical(),
+				t);
+	for (size_t r = 0; r < regionWriters.size(); r++) {
+		if (regionWriters[r])
+			regionWriters[r]->writeTimeStep(
+					simulation.getWaterHeight(),
+					simulation.getMomentumHorizontal(),
+					simulation.getMomentumVertical(),
+					t);
+	}
+	if (gaugeWriter)
+		gaugeWriter->record(
+				simulation.getWaterHeight(),
+				simulation.getMomentumHorizontal(),
+				simulation.getMomentumVertical(),
+				t);
 
 
 	/********************
@@ -199,12 +537,12 @@ int main(int argc, char** argv) {
 
 	float wallTime = 0.;
 
-	t = 0.0;
+	// Restart files, possibly only with the changes since the previous one
+	RestartFile restartFile(outputBaseName + "_restart", restartFullInterval);
 
 	float timestep;
-	unsigned int iterations = 0;
 	// loop over the count of requested checkpoints
-	for(int i = 0; i < numberOfCheckPoints; i++) {
+	for(int i = firstCheckPoint; i < numberOfCheckPoints; i++) {
 		// Simulate until the checkpoint is reached
 		while(t < checkpointInstantOfTime[i]) {
 			// Start measurement
@@ -232,16 +570,49 @@ int main(int argc, char** argv) {
 			// update simulation time with time step width.
 			t += timestep;
 			iterations++;
+
+			// move the sea floor if the scenario has a time-dependent displacement
+			if (initialScenario)
+				simulation.updateDisplacement(*initialScenario, t);
+
+			// the gauges are recorded after every time step
+			if (gaugeWriter)
+				gaugeWriter->record(
+						simulation.getWaterHeight(),
+						simulation.getMomentumHorizontal(),
+						simulation.getMomentumVertical(),
+						t);
 		}
 
 		printf("Write timestep (%fs)\n", t);
 
 		// write output
-		writer.writeTimeStep(
-				simulation.getWaterHeight(),
-				simulation.getMomentumHorizontal(),
-				simulation.getMomentumVertical(),
-				t);
+		if (outputInterval > 0 && (i + 1) % outputInterval == 0)
+			output->writeTimeStep(
+					simulation.getWaterHeight(),
+					simulation.getMomentumHorizontal(),
+					simulation.getMomentumVertical(),
+					t);
+		for (size_t r = 0; r < regionWriters.size(); r++) {
+			if (regionWriters[r] && (i + 1) % outputRegions[r].interval == 0)
+				regionWriters[r]->writeTimeStep(
+						simulation.getWaterHeight(),
+						simulation.getMomentumHorizontal(),
+						simulation.getMomentumVertical(),
+						t);
+		}
+
+		// write the complete state, a later run can resume from here
+		if (restartInterval > 0 && (i + 1) % restartInterval == 0) {
+			RestartFile::Header restartHeader = RestartFile::Header();
+			restartHeader.blockCountX = 1;
+			restartHeader.blockCountY = 1;
+			restartHeader.checkpoint = i + 1;
+			restartHeader.iteration = iterations;
+			restartHeader.time = t;
+			SWE_RestartScenario::storeDomain(*scenario, restartHeader);
+			simulation.writeRestart(restartFile, restartHeader);
+		}
 	}
 
 
@@ -250,6 +621,23 @@ int main(int argc, char** argv) {
 	 ************/
 
 
+#ifdef ASYNC_WRITER
+	// Writes the queued snapshots
+	if (output != &writer)
+		delete output;
+#endif
+#ifdef WRITENETCDF
+	if (simulation.hasEnvelope())
+		writer.writeEnvelope(simulation.getMaxWaveHeight(), simulation.getMaxSpeed(), simulation.getArrivalTime());
+#endif
+	for (size_t r = 0; r < regionWriters.size(); r++)
+		delete regionWriters[r];
+	// Writes the remaining gauge records
+	delete gaugeWriter;
+	if (scenario != initialScenario)
+		delete scenario;
+	delete initialScenario;
+
 	printf("SMP : Compute Time (CPU): %fs - (WALL): %fs | Total Time (Wall): %fs\n", simulation.computeTime, simulation.computeTimeWall, wallTime); 
 
 	return 0;
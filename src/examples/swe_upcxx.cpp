@@ -35,17 +35,25 @@
 #include <time.h>
 #include <unistd.h>
 #include <limits.h>
+#include <vector>
 
 #include "tools/args.hh"
 
-#ifdef WRITENETCDF
+#if defined(STREAM_OUTPUT)
+#include "writer/StreamWriter.hh"
+#elif defined(WRITENETCDF)
 #include "writer/NetCdfWriter.hh"
 #else
 #include "writer/VtkWriter.hh"
 #endif
+#ifdef ASYNC_WRITER
+#include "writer/AsyncWriter.hh"
+#endif
 
-#ifdef ASAGI
+#if defined(ASAGI)
 #include "scenarios/SWE_AsagiScenario.hh"
+#elif defined(READNETCDF)
+#include "scenarios/SWE_NetCdfScenario.hh"
 #else
 #include "scenarios/SWE_simple_scenarios.hh"
 #endif
@@ -64,15 +72,36 @@ int main(int argc, char** argv) {
 	// Define command line arguments
 	tools::Args args;
 
-#ifdef ASAGI
+#if defined(ASAGI) || defined(READNETCDF)
 	args.addOption("bathymetry-file", 'b', "File containing the bathymetry");
 	args.addOption("displacement-file", 'd', "File containing the displacement");
+#endif
+#ifdef READNETCDF
+	args.addOption("resampling", 0, "Sampling of the input on the cells: nearest, bilinear or conservative (default nearest)", tools::Args::Required, false);
 #endif
 	args.addOption("simulation-duration", 't', "Time in seconds to simulate");
 	args.addOption("checkpoint-count", 'n', "Number of simulation snapshots to be written");
 	args.addOption("resolution-horizontal", 'x', "Number of simulation cells in horizontal direction");
 	args.addOption("resolution-vertical", 'y', "Number of simulated cells in y-direction");
 	args.addOption("output-basepath", 'o', "Output base file name");
+	args.addOption("output-interval", 0, "Write the full output every n-th checkpoint, 0 disables it (default 1)", tools::Args::Required, false);
+	args.addOption("output-region", 0, "Additional outputs xmin,xmax,ymin,ymax[,stride[,interval]], separated by ';'", tools::Args::Required, false);
+	args.addOption("output-fields", 0, "Written fields out of h,hu,hv,eta,speed,froude (default h,hu,hv)", tools::Args::Required, false);
+#ifdef WRITENETCDF
+	args.addOption("chunk-size", 0, "Chunk shape of the netCDF output as time,y,x (0 = whole dimension, chosen by the library if not set)", tools::Args::Required, false);
+	args.addOption("deflate", 0, "Deflate level of the netCDF output (0-9, default 0)", tools::Args::Required, false);
+	args.addOption("shuffle", 0, "Shuffle the netCDF output before deflating", tools::Args::No, false);
+	args.addOption("significant-digits", 0, "Significant decimal digits kept in the netCDF output (lossy, default all)", tools::Args::Required, false);
+	args.addOption("io-report", 0, "Print throughput and compression ratio of every snapshot", tools::Args::No, false);
+	args.addOption("envelope", 0, "Write the maximum wave height, maximum speed and arrival time at the end", tools::Args::No, false);
+	args.addOption("arrival-threshold", 0, "Deviation of the surface elevation which marks the arrival of the wave (default 0.01)", tools::Args::Required, false);
+#endif
+#ifdef ASYNC_WRITER
+	args.addOption("writer-queue", 'q', "Number of snapshots queued for the output thread, 0 writes synchronously (default 2)", tools::Args::Required, false);
+#endif
+#ifdef STREAM_OUTPUT
+	args.addOption("stream-engine", 0, "Engine of the output stream: file (default), socket or shm", tools::Args::Required, false);
+#endif
 
 
 	// Declare the variables needed to hold command line input
@@ -81,6 +110,23 @@ int main(int argc, char** argv) {
 	int nxRequested;
 	int nyRequested;
 	std::string outputBaseName;
+	unsigned int outputInterval;
+	std::string outputRegionList;
+	std::vector<Writer::Field> outputFields;
+#ifdef STREAM_OUTPUT
+	std::string streamEngine;
+#endif
+#ifdef READNETCDF
+	SWE_NetCdfScenario::Resampling resampling;
+#endif
+#ifdef WRITENETCDF
+	NetCdfWriter::Options netCdfOptions;
+	bool envelope;
+	float arrivalThreshold;
+#endif
+#ifdef ASYNC_WRITER
+	int writerQueueDepth;
+#endif
 
 	// Declare variables for the output and the simulation time
 	std::string outputFileName;
@@ -104,10 +150,48 @@ int main(int argc, char** argv) {
 	nxRequested = args.getArgument<int>("resolution-horizontal");
 	nyRequested = args.getArgument<int>("resolution-vertical");
 	outputBaseName = args.getArgument<std::string>("output-basepath");
+	outputInterval = args.getArgument<unsigned int>("output-interval", 1);
+	outputRegionList = args.getArgument<std::string>("output-region", "");
+	if (!Writer::parseFields(args.getArgument<std::string>("output-fields", "h,hu,hv"), outputFields)) {
+		std::cerr << "Unknown output field in " << args.getArgument<std::string>("output-fields") << std::endl;
+		return 1;
+	}
+#ifdef WRITENETCDF
+	if (args.isSet("chunk-size")) {
+		netCdfOptions.chunked = true;
+		sscanf(args.getArgument<std::string>("chunk-size").c_str(), "%u,%u,%u",
+				&netCdfOptions.chunkTime, &netCdfOptions.chunkY, &netCdfOptions.chunkX);
+	}
+	netCdfOptions.deflateLevel = args.getArgument<int>("deflate", 0);
+	netCdfOptions.shuffle = args.isSet("shuffle");
+	netCdfOptions.significantDigits = args.getArgument<int>("significant-digits", 0);
+	netCdfOptions.report = args.isSet("io-report");
+	envelope = args.isSet("envelope");
+	arrivalThreshold = args.getArgument<float>("arrival-threshold", .01f);
+#endif
+#ifdef ASYNC_WRITER
+	writerQueueDepth = args.getArgument<int>("writer-queue", 2);
+#endif
+#ifdef READNETCDF
+	if (!SWE_NetCdfScenario::parseResampling(args.getArgument<std::string>("resampling", "nearest"), resampling)) {
+		std::cerr << "Unknown resampling: " << args.getArgument<std::string>("resampling") << std::endl;
+		return 1;
+	}
+#endif
+#ifdef STREAM_OUTPUT
+	streamEngine = args.getArgument<std::string>("stream-engine", "file");
+	if (streamEngine != "file" && streamEngine != "socket" && streamEngine != "shm") {
+		std::cerr << "Unknown stream engine: " << streamEngine << std::endl;
+		return 1;
+	}
+#endif
 
 	// Initialize Scenario
-#ifdef ASAGI
+#if defined(ASAGI)
 	SWE_AsagiScenario scenario(args.getArgument<std::string>("bathymetry-file"), args.getArgument<std::string>("displacement-file"));
+#elif defined(READNETCDF)
+	SWE_NetCdfScenario scenario(args.getArgument<std::string>("bathymetry-file"), args.getArgument<std::string>("displacement-file"));
+	scenario.setResampling(resampling);
 #else
 	SWE_RadialDamBreakScenario scenario;
 #endif
@@ -192,6 +276,11 @@ int main(int argc, char** argv) {
 
 	// Initialize the simulation block according to the scenario
 	SWE_DimensionalSplittingUpcxx simulation(nxLocal, nyLocal, dxSimulation, dySimulation, localOriginX, localOriginY);
+#ifdef READNETCDF
+	// Only the part of the input covering this block is read
+	scenario.loadRegion(localOriginX, localOriginX + nxLocal * dxSimulation,
+			localOriginY, localOriginY + nyLocal * dySimulation, 2);
+#endif
 	simulation.initScenario(scenario, boundaries);
 
 	// calculate neighbours to the current ranks simulation block
@@ -255,7 +344,20 @@ int main(int argc, char** argv) {
 	// Initialize boundary size of the ghost layers
 	BoundarySize boundarySize = {{1, 1, 1, 1}};
 	outputFileName = generateBaseFileName(outputBaseName, localBlockPositionX, localBlockPositionY);
-#ifdef WRITENETCDF
+#if defined(STREAM_OUTPUT)
+	// Construct a stream writer
+	StreamWriter writer(
+			outputFileName,
+			simulation.getBathymetry(),
+			boundarySize,
+			nxLocal,
+			nyLocal,
+			dxSimulation,
+			dySimulation,
+			simulation.getOriginX(),
+			simulation.getOriginY(),
+			StreamEngine::create(streamEngine, outputFileName));
+#elif defined(WRITENETCDF)
 	// Construct a netCDF writer
 	NetCdfWriter writer(
 			outputFileName,
@@ -266,7 +368,9 @@ int main(int argc, char** argv) {
 			dxSimulation,
 			dySimulation,
 			simulation.getOriginX(),
-			simulation.getOriginY());
+			simulation.getOriginY(),
+			0,
+			netCdfOptions);
 #else
 	// Construct a vtk writer
 	VtkWriter writer(
@@ -276,15 +380,125 @@ int main(int argc, char** argv) {
 			nxLocal,
 			nyLocal,
 			dxSimulation,
-			dySimulation);
+			dySimulation,
+			localBlockPositionX * nxBlockSimulation,
+			localBlockPositionY * nyBlockSimulation);
+
+	// The first rank combines the blocks of each time step in a ParaView-Container-File
+	if (myUpcxxRank == 0 && blockCountX * blockCountY > 1) {
+		writer.setContainerBaseName(outputBaseName);
+		for (int x = 0; x < blockCountX; x++) {
+			for (int y = 0; y < blockCountY; y++) {
+				writer.addContainerPiece(
+						generateBaseFileName(outputBaseName, x, y),
+						x * nxBlockSimulation,
+						y * nyBlockSimulation,
+						(x < blockCountX - 1) ? nxBlockSimulation : nxRemainderSimulation,
+						(y < blockCountY - 1) ? nyBlockSimulation : nyRemainderSimulation);
+			}
+		}
+	}
 #endif // WRITENETCDF
 
+#ifdef WRITENETCDF
+	// The envelope is accumulated while the unknowns are updated
+	if (envelope)
+		simulation.enableEnvelope(arrivalThreshold, t);
+#endif
+
+	// Only the selected (possibly derived) fields are written
+	writer.setFields(outputFields);
+
+	// All snapshots go through output, which may hand them to a background thread
+	Writer *output = &writer;
+#ifdef ASYNC_WRITER
+	if (writerQueueDepth > 0)
+		output = new AsyncWriter(*output, writerQueueDepth);
+#endif
+
+	// Additional writers for regions of interest, possibly with a coarser resolution
+	std::vector<OutputRegion> outputRegions;
+	if (!OutputRegion::parse(outputRegionList,
+			scenario.getBoundaryPos(BND_LEFT), scenario.getBoundaryPos(BND_BOTTOM),
+			dxSimulation, dySimulation,
+			localBlockPositionX * nxBlockSimulation, localBlockPositionY * nyBlockSimulation,
+			nxLocal, nyLocal,
+			outputRegions)) {
+		std::cerr << "Invalid output region: " << outputRegionList << std::endl;
+		upcxx::finalize();
+		return 1;
+	}
+	std::vector<Writer*> regionWriters(outputRegions.size());
+	for (size_t r = 0; r < outputRegions.size(); r++) {
+		const OutputRegion &region = outputRegions[r];
+		// This block does not contribute to the region
+		if (region.isEmpty())
+			continue;
+
+		std::ostringstream regionFileName;
+		regionFileName << outputFileName << "_region" << r;
+#if defined(STREAM_OUTPUT) || defined(WRITENETCDF)
+		const float regionOriginX = simulation.getOriginX() + region.firstX * dxSimulation;
+		const float regionOriginY = simulation.getOriginY() + region.firstY * dySimulation;
+#endif
+#if defined(STREAM_OUTPUT)
+		regionWriters[r] = new StreamWriter(
+				regionFileName.str(),
+				simulation.getBathymetry(),
+				boundarySize,
+				region.getNX(),
+				region.getNY(),
+				dxSimulation * region.strideX,
+				dySimulation * region.strideY,
+				regionOriginX,
+				regionOriginY,
+				StreamEngine::create(streamEngine, regionFileName.str()));
+#elif defined(WRITENETCDF)
+		regionWriters[r] = new NetCdfWriter(
+				regionFileName.str(),
+				simulation.getBathymetry(),
+				boundarySize,
+				region.getNX(),
+				region.getNY(),
+				dxSimulation * region.strideX,
+				dySimulation * region.strideY,
+				regionOriginX,
+				regionOriginY,
+				0,
+				netCdfOptions);
+#else
+		regionWriters[r] = new VtkWriter(
+				regionFileName.str(),
+				simulation.getBathymetry(),
+				boundarySize,
+				region.getNX(),
+				region.getNY(),
+				dxSimulation * region.strideX,
+				dySimulation * region.strideY,
+				region.offsetX,
+				region.offsetY,
+				region.domainFirstX * dxSimulation,
+				region.domainFirstY * dySimulation);
+#endif
+		regionWriters[r]->setRegion(region);
+		regionWriters[r]->setFields(outputFields);
+	}
+
 	// Write the output at t = 0
-	writer.writeTimeStep(
-			simulation.getWaterHeight(),
-			simulation.getMomentumHorizontal(),
-			simulation.getMomentumVertical(),
-			(float) 0.);
+	if (outputInterval > 0)
+		output->writeTimeStep(
+				simulation.getWaterHeight(),
+				simulation.getMomentumHorizontal(),
+				simulation.getMomentumVertical(),
+				(float) 0.);
+	for (size_t r = 0; r < regionWriters.size(); r++) {
+		if (regionWriters[r])
+			regionWriters[r]->writeTimeStep(
+					simulation.getWaterHeight(),
+					simulation.getMomentumHorizontal(),
+					simulation.getMomentumVertical(),
+					(float) 0.);
+	}
 
 
 	/********************
@@ -330,6 +544,14 @@ int main(int argc, char** argv) {
 			// update simulation time with time step width.
 			t += timestep;
 			iterations++;
+
+			// move the sea floor if the scenario has a time-dependent displacement,
+			// the bathymetry of the ghost layers is only exchanged while it changes
+			if (simulation.updateDisplacement(scenario, t)) {
+				// all copy layers have to be updated before they are read
+				upcxx::barrier();
+				simulation.exchangeBathymetry();
+			}
 			upcxx::barrier();
 		}
 
@@ -338,11 +560,20 @@ int main(int argc, char** argv) {
 		}
 
 		// write output
-		writer.writeTimeStep(
-				simulation.getWaterHeight(),
-				simulation.getMomentumHorizontal(),
-				simulation.getMomentumVertical(),
-				t);
+		if (outputInterval > 0 && (i + 1) % outputInterval == 0)
+			output->writeTimeStep(
+					simulation.getWaterHeight(),
+					simulation.getMomentumHorizontal(),
+					simulation.getMomentumVertical(),
+					t);
+		for (size_t r = 0; r < regionWriters.size(); r++) {
+			if (regionWriters[r] && (i + 1) % outputRegions[r].interval == 0)
+				regionWriters[r]->writeTimeStep(
+						simulation.getWaterHeight(),
+						simulation.getMomentumHorizontal(),
+						simulation.getMomentumVertical(),
+						t);
+		}
 	}
 
 
@@ -350,6 +581,18 @@ int main(int argc, char** argv) {
 	 * FINALIZE *
 	 ************/
 
+#ifdef ASYNC_WRITER
+	// Writes the queued snapshots
+	if (output != &writer)
+		delete output;
+#endif
+#ifdef WRITENETCDF
+	if (simulation.hasEnvelope())
+		writer.writeEnvelope(simulation.getMaxWaveHeight(), simulation.getMaxSpeed(), simulation.getArrivalTime());
+#endif
+	for (size_t r = 0; r < regionWriters.size(); r++)
+		delete regionWriters[r];
+
 	printf("Rank %i : Compute Time (CPU): %fs - (WALL): %fs | Total Time (Wall): %fs\n", myUpcxxRank, simulation.computeTime, simulation.computeTimeWall, wallTime); 
 
 	upcxx::finalize();
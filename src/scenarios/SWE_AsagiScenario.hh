@@ -24,11 +24,19 @@
  * @section DESCRIPTION
  
  * Access to bathymetry and displacement files with ASAGI.
+ *
+ * With DYNAMIC_DISPLACEMENTS, the displacement grid has the time as third
+ * dimension. Before the first and after the last snapshot the displacement
+ * of the first/last snapshot is used.
+ *
+ * Coarse simulations can use a coarsened copy of the bathymetry
+ * (see selectResolution()).
  */
 
 #ifndef __SWE_ASAGISCENARIO_HH
 #define __SWE_ASAGISCENARIO_HH
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <string>
@@ -36,6 +44,7 @@
 #include <map>
 #include <asagi.h>
 #include "SWE_Scenario.hh"
+#include "tools/InputPyramid.hh"
 
 using namespace asagi;
 
@@ -43,7 +52,9 @@ class SWE_AsagiScenario: public SWE_Scenario {
 	public:
 		SWE_AsagiScenario(
 				const std::string bathymetryFilename,
-				const std::string displacementFilename) {
+				const std::string displacementFilename) :
+			bathymetryFilename(bathymetryFilename),
+			levelFilename(bathymetryFilename) {
 
 			bathymetryGrid = Grid::create();
 			displacementGrid = Grid::create();
@@ -66,6 +77,10 @@ class SWE_AsagiScenario: public SWE_Scenario {
 			displacementRange[1] = displacementGrid->getMax(0);
 			displacementRange[2] = displacementGrid->getMin(1);
 			displacementRange[3] = displacementGrid->getMax(1);
+#ifdef DYNAMIC_DISPLACEMENTS
+			displacementRange[4] = displacementGrid->getMin(2);
+			displacementRange[5] = displacementGrid->getMax(2);
+#endif
 
 #ifndef NDEBUG
 		//print information
@@ -78,6 +93,10 @@ class SWE_AsagiScenario: public SWE_Scenario {
 			<< "    displacementRange[1]=" << displacementRange[1] << std::endl
 			<< "    displacementRange[2]=" << displacementRange[2] << std::endl
 			<< "    displacementRange[3]=" << displacementRange[3] << std::endl;
+#ifdef DYNAMIC_DISPLACEMENTS
+		std::cout << "    displacementRange[4]=" << displacementRange[4] << std::endl
+			<< "    displacementRange[5]=" << displacementRange[5] << std::endl;
+#endif
 #endif
 		}
 
@@ -86,6 +105,32 @@ class SWE_AsagiScenario: public SWE_Scenario {
 			delete displacementGrid;
 		}
 
+		/**
+		 * Uses the coarsest level of the bathymetry pyramid (see InputPyramid)
+		 * which still resolves cells of size dx x dy. The domain remains the domain
+		 * of the original bathymetry.
+		 */
+		void selectResolution(float dx, float dy) {
+			const std::string fileName = InputPyramid::select(bathymetryFilename, dx, dy);
+			if (fileName == levelFilename)
+				return;
+			levelFilename = fileName;
+
+			delete bathymetryGrid;
+			bathymetryGrid = Grid::create();
+			if(bathymetryGrid->open(fileName.c_str()) != Grid::SUCCESS) {
+				std::cout << "Could not open bathymetry file: " << fileName << std::endl;
+				assert(false);
+			}
+		}
+
+		/**
+		 * @return the file the bathymetry is read from (the original one or a level of its pyramid)
+		 */
+		const std::string& getBathymetryFilename() const {
+			return levelFilename;
+		}
+
 		float getWaterHeight(float x, float y) {
 			assert(x > bathymetryRange[0]);
 			assert(x < bathymetryRange[1]);
@@ -118,12 +163,70 @@ class SWE_AsagiScenario: public SWE_Scenario {
 					x < displacementRange[1] &&
 					y > displacementRange[2] &&
 					y < displacementRange[3]) {
-				displacementValue = displacementGrid->getFloat(position);
+				displacementValue = sampleDisplacement(x, y, 0);
 			}
 
 			return bathymetryValue + displacementValue;
 		}
 
+		float getDisplacement(float x, float y) {
+			if (x > displacementRange[0] &&
+					x < displacementRange[1] &&
+					y > displacementRange[2] &&
+					y < displacementRange[3]) {
+				return sampleDisplacement(x, y, 0);
+			}
+			return 0;
+		}
+
+#ifdef DYNAMIC_DISPLACEMENTS
+		float getDynamicDisplacement(float x, float y, float time) {
+			if (x > displacementRange[0] &&
+					x < displacementRange[1] &&
+					y > displacementRange[2] &&
+					y < displacementRange[3]) {
+				return sampleDisplacement(x, y, time);
+			}
+			return 0;
+		}
+
+		bool getDisplacementChange(float time0, float time1, float o_region[4]) {
+			// The displacement changes only between the first and the last snapshot
+			if (time1 <= displacementRange[4] || time0 >= displacementRange[5] || time0 == time1)
+				return false;
+
+			std::copy(displacementRange, displacementRange + 4, o_region);
+			return true;
+		}
+#endif
+
+		/**
+		 * Looks up the bathymetry only once per cell, the water is at rest.
+		 */
+		void getColumn(float x, float originY, float dx, float dy, int count,
+				float *o_b, float *o_h, float *o_hu, float *o_hv) {
+			assert(x > bathymetryRange[0]);
+			assert(x < bathymetryRange[1]);
+
+			const bool displaced = x > displacementRange[0] && x < displacementRange[1];
+
+			for (int i = 0; i < count; i++) {
+				const float y = originY + (i + 0.5) * dy;
+				assert(y > bathymetryRange[2]);
+				assert(y < bathymetryRange[3]);
+
+				double position[] = {x, y};
+				const float bathymetryValue = bathymetryGrid->getFloat(position);
+
+				o_b[i] = bathymetryValue;
+				if (displaced && y > displacementRange[2] && y < displacementRange[3])
+					o_b[i] += sampleDisplacement(x, y, 0);
+				o_h[i] = (bathymetryValue > (float) 0.) ? 0. : -bathymetryValue;
+				o_hu[i] = 0.;
+				o_hv[i] = 0.;
+			}
+		}
+
 		BoundaryType getBoundaryType(Boundary boundary) {
 			return OUTFLOW;
 		}
@@ -140,10 +243,32 @@ class SWE_AsagiScenario: public SWE_Scenario {
 		}
 
 	private:
+		/**
+		 * @return the displacement at a point inside of the displacement grid
+		 */
+		float sampleDisplacement(float x, float y, float time) {
+#ifdef DYNAMIC_DISPLACEMENTS
+			time = std::min(std::max(time, displacementRange[4]), displacementRange[5]);
+			double position[] = {x, y, time};
+#else
+			double position[] = {x, y};
+#endif
+			return displacementGrid->getFloat(position);
+		}
+
+		std::string bathymetryFilename;
+		//! selected level of the bathymetry pyramid
+		std::string levelFilename;
+
 		Grid* bathymetryGrid;
 		Grid* displacementGrid;
 
 		float bathymetryRange[4];
+#ifdef DYNAMIC_DISPLACEMENTS
+		// includes the time range
+		float displacementRange[6];
+#else
 		float displacementRange[4];
+#endif
 };
 #endif // __SWE_ASAGISCENARIO_HH
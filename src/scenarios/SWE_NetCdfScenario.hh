@@ -0,0 +1,801 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * Bathymetry and displacement read directly from netCDF files, block by block.
+ *
+ * The input files use the same layout as the ASAGI input: a 2D variable
+ * (z or the first 2D variable) with the dimensions (y, x) and 1D coordinate
+ * variables named like the dimensions, sampled on a uniform grid.
+ *
+ * The constructor reads only the metadata. Each block calls loadRegion() with
+ * its part of the domain, which reads the covered values and a small halo with
+ * one hyperslab per file. The memory of a block thus scales with the size of
+ * the block, not with the size of the input.
+ *
+ * With MPI, the ranks of a node can share their input (see shareNode()). The
+ * first rank of each node then reads the region covering all blocks of the
+ * node into a shared memory window, which the other ranks read directly.
+ *
+ * Inputs larger than the memory can be streamed instead (see stream()). The
+ * values are then read in square tiles when they are queried, and only a fixed
+ * number of recently used tiles is kept.
+ *
+ * Coarse simulations can read a coarsened copy of the bathymetry instead
+ * (see selectResolution()).
+ *
+ * The cells of the simulation take the value of the nearest input point by
+ * default. Alternatively, whole columns of cells are resampled at once, by
+ * bilinear interpolation or by averaging the input around the points covered
+ * by each cell (see Resampling).
+ */
+
+#ifndef __SWE_NETCDFSCENARIO_HH
+#define __SWE_NETCDFSCENARIO_HH
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cmath>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#ifdef USEMPI
+#include <mpi.h>
+#ifndef MPI_INCLUDED
+#define MPI_INCLUDED
+#define MPI_INCLUDED_NETCDF
+#endif
+#endif
+#include <netcdf.h>
+#ifdef NETCDF_PARALLEL
+#include <netcdf_par.h>
+#endif
+#ifdef MPI_INCLUDED_NETCDF
+#undef MPI_INCLUDED
+#undef MPI_INCLUDED_NETCDF
+#endif
+
+#include "SWE_Scenario.hh"
+#include "tools/InputPyramid.hh"
+
+class SWE_NetCdfScenario : public SWE_Scenario {
+	private:
+		/**
+		 * One input file, of which only a rectangular region is kept in memory
+		 */
+		class InputGrid {
+			public:
+				/** Number of values in each direction of a streamed tile */
+				static const int tileSize = 256;
+
+				/** Values of a streamed tile */
+				struct Tile {
+					int firstX, firstY;
+					int countX, countY;
+					std::vector<float> values;
+				};
+
+				/**
+				 * Tile used last by a caller, values in the same tile are
+				 * found without a cache lookup
+				 */
+				struct TileRef {
+					long key;
+					std::shared_ptr<const Tile> tile;
+
+					TileRef() : key(-1) {}
+				};
+
+				InputGrid(const std::string &i_fileName) :
+					firstX(0), firstY(0), countX(0), countY(0),
+					shared(0),
+					maxTiles(0), streamFile(-1)
+#ifdef USEMPI
+					, nodeComm(MPI_COMM_NULL), leaderComm(MPI_COMM_NULL), window(MPI_WIN_NULL)
+#endif
+					{
+					open(i_fileName);
+				}
+
+				~InputGrid() {
+					if (streamFile >= 0)
+						nc_close(streamFile);
+				}
+
+				/**
+				 * Reads the metadata of (another) input file, must be called before load()
+				 */
+				void open(const std::string &i_fileName) {
+					fileName = i_fileName;
+					if (streamFile >= 0)
+						nc_close(streamFile);
+					streamFile = -1;
+					tiles.clear();
+					leastRecentlyUsed.clear();
+
+					int file;
+					check(nc_open(fileName.c_str(), NC_NOWRITE, &file), "open");
+					findVariable(file);
+
+					int dims[2];
+					check(nc_inq_vardimid(file, var, dims), "read the dimensions of");
+					readCoordinates(file, dims[0], nY, originY, dY);
+					readCoordinates(file, dims[1], nX, originX, dX);
+
+					nc_close(file);
+				}
+
+				/**
+				 * Reads tiles on demand instead of regions.
+				 *
+				 * @param i_maxTiles number of tiles kept in memory, the least
+				 *                   recently used tile is dropped first.
+				 */
+				void stream(size_t i_maxTiles) {
+					maxTiles = std::max<size_t>(i_maxTiles, 1);
+				}
+
+#ifdef USEMPI
+				/**
+				 * Keeps the loaded values in memory shared by the ranks of i_nodeComm.
+				 *
+				 * @param i_leaderComm the first ranks of all nodes (MPI_COMM_NULL on the other ranks).
+				 */
+				void share(MPI_Comm i_nodeComm, MPI_Comm i_leaderComm) {
+					nodeComm = i_nodeComm;
+					leaderComm = i_leaderComm;
+				}
+#endif
+
+				/**
+				 * Reads all values covering [i_minX, i_maxX] x [i_minY, i_maxY]
+				 * and i_halo additional values in each direction.
+				 *
+				 * With a communicator or a shared grid, all ranks have to call this collectively.
+				 */
+				void load(float i_minX, float i_maxX, float i_minY, float i_maxY, int i_halo
+#ifdef NETCDF_PARALLEL
+						, MPI_Comm i_comm
+#endif
+						) {
+					// Streamed grids read their tiles when they are queried
+					if (maxTiles > 0)
+						return;
+
+					restrict(i_minX, i_maxX, i_halo, originX, dX, nX, firstX, countX);
+					restrict(i_minY, i_maxY, i_halo, originY, dY, nY, firstY, countY);
+
+#ifdef USEMPI
+					if (nodeComm != MPI_COMM_NULL) {
+						loadShared(
+#ifdef NETCDF_PARALLEL
+								i_comm
+#endif
+								);
+						return;
+					}
+#endif
+
+					values.resize(countX * countY);
+					read(values.data()
+#ifdef NETCDF_PARALLEL
+							, i_comm
+#endif
+							);
+				}
+
+				//! @return true if (x, y) is inside the grid
+				bool contains(float x, float y) const {
+					return x > originX && x < originX + (nX - 1) * dX
+							&& y > originY && y < originY + (nY - 1) * dY;
+				}
+
+				//! @return the value of the grid point nearest to (x, y), which must be in the loaded region
+				float get(float x, float y) const {
+					TileRef tile;
+					return get(x, y, tile);
+				}
+
+				/**
+				 * @param io_tile tile used by the last call of this caller (only used if the grid is streamed).
+				 * @return the value of the grid point nearest to (x, y)
+				 */
+				float get(float x, float y, TileRef &io_tile) const {
+					int i = std::lround((x - originX) / dX);
+					int j = std::lround((y - originY) / dY);
+					if (maxTiles > 0) {
+						i = std::min(std::max(i, 0), nX - 1);
+						j = std::min(std::max(j, 0), nY - 1);
+					}
+					return at(i, j, io_tile);
+				}
+
+				/**
+				 * @param io_tile tile used by the last call of this caller (only used if the grid is streamed).
+				 * @return the value of grid point (i, j), which must be in the loaded region
+				 */
+				float at(int i, int j, TileRef &io_tile) const {
+					if (maxTiles > 0) {
+						const long key = static_cast<long>(i / tileSize) * ((nY + tileSize - 1) / tileSize) + j / tileSize;
+						if (io_tile.key != key) {
+							io_tile.tile = fetch(key, i / tileSize, j / tileSize);
+							io_tile.key = key;
+						}
+
+						const Tile &tile = *io_tile.tile;
+						return tile.values[(j - tile.firstY) * tile.countX + i - tile.firstX];
+					}
+
+					assert(i >= firstX && i < firstX + countX);
+					assert(j >= firstY && j < firstY + countY);
+					return (shared ? shared : values.data())[(j - firstY) * countX + i - firstX];
+				}
+
+				int getNX() const { return nX; }
+				int getNY() const { return nY; }
+				float getDX() const { return dX; }
+				float getDY() const { return dY; }
+				float getMinX() const { return originX; }
+				float getMaxX() const { return originX + (nX - 1) * dX; }
+				float getMinY() const { return originY; }
+				float getMaxY() const { return originY + (nY - 1) * dY; }
+
+			private:
+				/**
+				 * Returns a tile from the cache or reads it, safe to call concurrently
+				 */
+				std::shared_ptr<const Tile> fetch(long i_key, int i_tileX, int i_tileY) const {
+					std::lock_guard<std::mutex> lock(tileMutex);
+
+					std::unordered_map<long, CachedTile>::iterator cached = tiles.find(i_key);
+					if (cached != tiles.end()) {
+						// Mark as most recently used
+						leastRecentlyUsed.splice(leastRecentlyUsed.begin(), leastRecentlyUsed, cached->second.second);
+						return cached->second.first;
+					}
+
+					std::shared_ptr<Tile> tile(new Tile());
+					tile->firstX = i_tileX * tileSize;
+					tile->firstY = i_tileY * tileSize;
+					tile->countX = std::min(nX - tile->firstX, static_cast<int>(tileSize));
+					tile->countY = std::min(nY - tile->firstY, static_cast<int>(tileSize));
+					tile->values.resize(tile->countX * tile->countY);
+
+					// netCDF is not thread-safe, the file is read while holding the lock
+					if (streamFile < 0)
+						check(nc_open(fileName.c_str(), NC_NOWRITE, &streamFile), "open");
+					size_t start[2] = {static_cast<size_t>(tile->firstY), static_cast<size_t>(tile->firstX)};
+					size_t count[2] = {static_cast<size_t>(tile->countY), static_cast<size_t>(tile->countX)};
+					check(nc_get_vara_float(streamFile, var, start, count, tile->values.data()), "read");
+
+					// Tiles still used by a caller are freed once the caller moves on
+					leastRecentlyUsed.push_front(i_key);
+					tiles[i_key] = CachedTile(tile, leastRecentlyUsed.begin());
+					while (tiles.size() > maxTiles) {
+						tiles.erase(leastRecentlyUsed.back());
+						leastRecentlyUsed.pop_back();
+					}
+
+					return tile;
+				}
+
+				/**
+				 * Reads the current region from the file
+				 */
+				void read(float *o_values
+#ifdef NETCDF_PARALLEL
+						, MPI_Comm i_comm
+#endif
+						) {
+					int file;
+#ifdef NETCDF_PARALLEL
+					if (i_comm != MPI_COMM_NULL) {
+						check(nc_open_par(fileName.c_str(), NC_NOWRITE | NC_MPIIO, i_comm, MPI_INFO_NULL, &file), "open");
+						check(nc_var_par_access(file, var, NC_COLLECTIVE), "access");
+					} else
+#endif
+					check(nc_open(fileName.c_str(), NC_NOWRITE, &file), "open");
+
+					// Blocks outside of the grid still take part in a collective read
+					size_t start[2] = {static_cast<size_t>(firstY), static_cast<size_t>(firstX)};
+					size_t count[2] = {static_cast<size_t>(countY), static_cast<size_t>(countX)};
+					check(nc_get_vara_float(file, var, start, count, o_values), "read");
+
+					nc_close(file);
+				}
+
+#ifdef USEMPI
+				/**
+				 * Loads the region covering the regions of all ranks of the node
+				 * into a shared window, only the first rank of the node reads it.
+				 */
+				void loadShared(
+#ifdef NETCDF_PARALLEL
+						MPI_Comm i_comm
+#endif
+						) {
+					// Bounding box of the node, empty regions do not count
+					int region[4] = {-INT_MAX, -INT_MAX, -INT_MAX, -INT_MAX};
+					if (countX > 0 && countY > 0) {
+						region[0] = -firstX;
+						region[1] = -firstY;
+						region[2] = firstX + countX;
+						region[3] = firstY + countY;
+					}
+					MPI_Allreduce(MPI_IN_PLACE, region, 4, MPI_INT, MPI_MAX, nodeComm);
+					firstX = std::max(0, -region[0]);
+					firstY = std::max(0, -region[1]);
+					countX = std::max(0, region[2] - firstX);
+					countY = std::max(0, region[3] - firstY);
+
+					// A previous region is replaced, the window of the last region is freed by MPI_Finalize()
+					if (window != MPI_WIN_NULL)
+						MPI_Win_free(&window);
+					values.clear();
+
+					int nodeRank;
+					MPI_Comm_rank(nodeComm, &nodeRank);
+					const MPI_Aint size = (nodeRank == 0) ? static_cast<MPI_Aint>(countX) * countY * sizeof(float) : 0;
+					float *base;
+					MPI_Win_allocate_shared(size, sizeof(float), MPI_INFO_NULL, nodeComm, &base, &window);
+					MPI_Aint sharedSize;
+					int unit;
+					MPI_Win_shared_query(window, 0, &sharedSize, &unit, &shared);
+
+					MPI_Win_fence(0, window);
+					if (nodeRank == 0) {
+#ifdef NETCDF_PARALLEL
+						// The first ranks of all nodes read collectively
+						read(shared, (i_comm != MPI_COMM_NULL) ? leaderComm : MPI_COMM_NULL);
+#else
+						read(shared);
+#endif
+					}
+					// The other ranks of the node see the values after the fence
+					MPI_Win_fence(0, window);
+				}
+#endif
+
+				void check(int i_status, const char *i_action) const {
+					if (i_status != NC_NOERR) {
+						std::cerr << "Could not " << i_action << " " << fileName << ": " << nc_strerror(i_status) << std::endl;
+						assert(false);
+					}
+				}
+
+				/**
+				 * Uses the variable z or, if it does not exist, the first 2D variable
+				 */
+				void findVariable(int i_file) {
+					if (nc_inq_varid(i_file, "z", &var) == NC_NOERR)
+						return;
+
+					int varCount;
+					check(nc_inq_nvars(i_file, &varCount), "read the variables of");
+					for (var = 0; var < varCount; var++) {
+						int dimCount;
+						nc_inq_varndims(i_file, var, &dimCount);
+						if (dimCount == 2)
+							return;
+					}
+					check(NC_ENOTVAR, "find a 2D variable in");
+				}
+
+				/**
+				 * Reads size, first coordinate and spacing of a dimension
+				 */
+				void readCoordinates(int i_file, int i_dim, int &o_n, float &o_origin, float &o_d) {
+					char name[NC_MAX_NAME + 1];
+					size_t n;
+					check(nc_inq_dim(i_file, i_dim, name, &n), "read a dimension of");
+					assert(n > 1);
+					o_n = n;
+
+					int coordinates;
+					check(nc_inq_varid(i_file, name, &coordinates), "find the coordinates in");
+					size_t index = 0;
+					check(nc_get_var1_float(i_file, coordinates, &index, &o_origin), "read the coordinates of");
+					float last;
+					index = n - 1;
+					check(nc_get_var1_float(i_file, coordinates, &index, &last), "read the coordinates of");
+					o_d = (last - o_origin) / (n - 1);
+					assert(o_d > 0);
+				}
+
+				/**
+				 * Computes the grid points covering [i_min, i_max] in one direction
+				 */
+				static void restrict(float i_min, float i_max, int i_halo,
+						float i_origin, float i_d, int i_n,
+						int &o_first, int &o_count) {
+					const int first = std::max<int>(0, std::floor((i_min - i_origin) / i_d) - i_halo);
+					const int last = std::min<int>(i_n - 1, std::ceil((i_max - i_origin) / i_d) + i_halo);
+					o_first = std::min(first, i_n - 1);
+					o_count = std::max(0, last - first + 1);
+				}
+
+				std::string fileName;
+				int var;
+
+				// Whole grid
+				int nX, nY;
+				float originX, originY;
+				float dX, dY;
+
+				// Loaded region
+				int firstX, firstY;
+				int countX, countY;
+				std::vector<float> values;
+				// Values of the node, if the region is shared
+				float *shared;
+
+				// Streamed tiles
+				typedef std::pair<std::shared_ptr<const Tile>, std::list<long>::iterator> CachedTile;
+				size_t maxTiles;
+				mutable int streamFile;
+				mutable std::mutex tileMutex;
+				mutable std::unordered_map<long, CachedTile> tiles;
+				mutable std::list<long> leastRecentlyUsed;
+
+#ifdef USEMPI
+				MPI_Comm nodeComm;
+				MPI_Comm leaderComm;
+				MPI_Win window;
+#endif
+		};
+
+	public:
+		/**
+		 * Mapping of the input grids to the cells of the simulation
+		 */
+		enum Resampling {
+			NEAREST,		// value of the nearest input point
+			BILINEAR,		// bilinear interpolation of the four surrounding input points
+			CONSERVATIVE	// average of the input overlapped by a cell, each point stands for the area around it
+		};
+
+		SWE_NetCdfScenario(
+				const std::string &bathymetryFilename,
+				const std::string &displacementFilename) :
+			bathymetryFilename(bathymetryFilename),
+			levelFilename(bathymetryFilename),
+			resampling(NEAREST),
+			bathymetryGrid(bathymetryFilename),
+			displacementGrid(displacementFilename) {
+			bathymetryRange[0] = bathymetryGrid.getMinX();
+			bathymetryRange[1] = bathymetryGrid.getMaxX();
+			bathymetryRange[2] = bathymetryGrid.getMinY();
+			bathymetryRange[3] = bathymetryGrid.getMaxY();
+		}
+
+		/**
+		 * Reads the bathymetry from the coarsest level of its pyramid (see InputPyramid)
+		 * which still resolves cells of size dx x dy. The domain remains the domain of
+		 * the original bathymetry. Must be called before loadRegion().
+		 */
+		void selectResolution(float dx, float dy) {
+			const std::string fileName = InputPyramid::select(bathymetryFilename, dx, dy);
+			if (fileName != levelFilename)
+				bathymetryGrid.open(fileName);
+			levelFilename = fileName;
+		}
+
+		/**
+		 * @return the file the bathymetry is read from (the original one or a level of its pyramid)
+		 */
+		const std::string& getBathymetryFilename() const {
+			return levelFilename;
+		}
+
+		/**
+		 * Parses the name of a resampling mode (nearest, bilinear or conservative).
+		 *
+		 * @return false if the name is unknown.
+		 */
+		static bool parseResampling(const std::string &i_name, Resampling &o_resampling) {
+			static const char* const names[] = {"nearest", "bilinear", "conservative"};
+			for (int i = 0; i < 3; i++) {
+				if (i_name == names[i]) {
+					o_resampling = static_cast<Resampling>(i);
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/**
+		 * Selects how getColumn() samples the input
+		 */
+		void setResampling(Resampling i_resampling) {
+			resampling = i_resampling;
+		}
+
+		Resampling getResampling() const {
+			return resampling;
+		}
+
+		/**
+		 * Reads the input in tiles while the scenario is queried, instead of
+		 * loading whole regions. Loading a region then has no effect.
+		 *
+		 * @param cacheSize memory for the tiles of each input file (in bytes).
+		 */
+		void stream(size_t cacheSize) {
+			const size_t tileBytes = InputGrid::tileSize * InputGrid::tileSize * sizeof(float);
+			bathymetryGrid.stream(cacheSize / tileBytes);
+			displacementGrid.stream(cacheSize / tileBytes);
+		}
+
+#ifdef USEMPI
+		/**
+		 * Shares the input between the ranks of each node, the first rank of a
+		 * node reads the regions of all ranks of the node.
+		 * Must be called collectively before loadRegion(), all later loads
+		 * become collective for the ranks of comm.
+		 */
+		void shareNode(MPI_Comm comm) {
+			int rank;
+			MPI_Comm_rank(comm, &rank);
+
+			MPI_Comm nodeComm;
+			MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &nodeComm);
+			int nodeRank;
+			MPI_Comm_rank(nodeComm, &nodeRank);
+			MPI_Comm leaderComm;
+			MPI_Comm_split(comm, (nodeRank == 0) ? 0 : MPI_UNDEFINED, rank, &leaderComm);
+
+			bathymetryGrid.share(nodeComm, leaderComm);
+			displacementGrid.share(nodeComm, leaderComm);
+		}
+#endif
+
+		/**
+		 * Reads the input for the part [minX, maxX] x [minY, maxY] of the domain,
+		 * must be called before the scenario is queried.
+		 *
+		 * @param halo number of additional input values read in each direction.
+		 * @param comm read collectively with parallel netCDF (all ranks of comm call this).
+		 */
+		void loadRegion(float minX, float maxX, float minY, float maxY, int halo = 2
+#ifdef NETCDF_PARALLEL
+				, MPI_Comm comm = MPI_COMM_NULL
+#endif
+				) {
+			bathymetryGrid.load(minX, maxX, minY, maxY, halo
+#ifdef NETCDF_PARALLEL
+					, comm
+#endif
+					);
+			loadDisplacement(minX, maxX, minY, maxY, halo
+#ifdef NETCDF_PARALLEL
+					, comm
+#endif
+					);
+		}
+
+		/**
+		 * Reads only the displacement, sufficient for getDisplacement()
+		 *
+		 * @see loadRegion()
+		 */
+		void loadDisplacement(float minX, float maxX, float minY, float maxY, int halo = 2
+#ifdef NETCDF_PARALLEL
+				, MPI_Comm comm = MPI_COMM_NULL
+#endif
+				) {
+			displacementGrid.load(minX, maxX, minY, maxY, halo
+#ifdef NETCDF_PARALLEL
+					, comm
+#endif
+					);
+		}
+
+		float getWaterHeight(float x, float y) {
+			const float bathymetryValue = bathymetryGrid.get(x, y);
+
+			if (bathymetryValue > (float) 0.)
+				return 0.;
+			else
+				return -bathymetryValue;
+		}
+
+		float getBathymetry(float x, float y) {
+			float bathymetryValue = bathymetryGrid.get(x, y);
+			if (displacementGrid.contains(x, y))
+				bathymetryValue += displacementGrid.get(x, y);
+			return bathymetryValue;
+		}
+
+		float getDisplacement(float x, float y) {
+			if (displacementGrid.contains(x, y))
+				return displacementGrid.get(x, y);
+			return 0;
+		}
+
+		/**
+		 * Looks up the bathymetry only once per cell, the water is at rest.
+		 */
+		void getColumn(float x, float originY, float dx, float dy, int count,
+				float *o_b, float *o_h, float *o_hu, float *o_hv) {
+			// A column crosses only a few tiles of a streamed input
+			InputGrid::TileRef bathymetryTile;
+			InputGrid::TileRef displacementTile;
+
+			if (resampling != NEAREST) {
+				// The bathymetry is extended beyond its grid, there is no displacement outside of its grid
+				resampleColumn(bathymetryGrid, bathymetryTile, false, x, originY, dx, dy, count, o_b);
+				resampleColumn(displacementGrid, displacementTile, true, x, originY, dx, dy, count, o_hu);
+				for (int i = 0; i < count; i++) {
+					o_h[i] = (o_b[i] > (float) 0.) ? 0. : -o_b[i];
+					o_b[i] += o_hu[i];
+					o_hu[i] = 0.;
+					o_hv[i] = 0.;
+				}
+				return;
+			}
+
+			for (int i = 0; i < count; i++) {
+				const float y = originY + (i + 0.5) * dy;
+
+				const float bathymetryValue = bathymetryGrid.get(x, y, bathymetryTile);
+				o_b[i] = bathymetryValue;
+				if (displacementGrid.contains(x, y))
+					o_b[i] += displacementGrid.get(x, y, displacementTile);
+				o_h[i] = (bathymetryValue > (float) 0.) ? 0. : -bathymetryValue;
+				o_hu[i] = 0.;
+				o_hv[i] = 0.;
+			}
+		}
+
+		BoundaryType getBoundaryType(Boundary boundary) {
+			return OUTFLOW;
+		}
+
+		float getBoundaryPos(Boundary boundary) {
+			if (boundary == BND_LEFT)
+				return bathymetryRange[0];
+			else if (boundary == BND_RIGHT)
+				return bathymetryRange[1];
+			else if (boundary == BND_BOTTOM)
+				return bathymetryRange[2];
+			else
+				return bathymetryRange[3];
+		}
+
+	private:
+		/**
+		 * Input points overlapped by [i_min, i_max] in one direction, each point
+		 * stands for the interval of width i_d around it.
+		 *
+		 * @param i_outsideZero parts of the interval outside of the grid count as zero,
+		 *        otherwise only the covered part is averaged and an interval outside of
+		 *        the grid takes the nearest point.
+		 * @param o_index the overlapped points.
+		 * @param o_weight the overlap of each point (in multiples of i_d).
+		 * @return the sum by which the weighted values are divided
+		 */
+		static float getOverlap(float i_min, float i_max, float i_origin, float i_d, int i_n, bool i_outsideZero,
+				std::vector<int> &o_index, std::vector<float> &o_weight) {
+			o_index.clear();
+			o_weight.clear();
+
+			const float first = (i_min - i_origin) / i_d + .5f;
+			const float last = (i_max - i_origin) / i_d + .5f;
+			float covered = 0;
+			for (int k = std::max(0, (int) std::floor(first)); k < std::min(i_n, (int) std::ceil(last)); k++) {
+				const float weight = std::min(last, k + 1.f) - std::max(first, (float) k);
+				if (weight > 0) {
+					o_index.push_back(k);
+					o_weight.push_back(weight);
+					covered += weight;
+				}
+			}
+
+			if (i_outsideZero)
+				return last - first;
+			if (o_index.empty()) {
+				o_index.push_back(std::min(std::max((int) std::floor(first), 0), i_n - 1));
+				o_weight.push_back(1);
+				return 1;
+			}
+			return covered;
+		}
+
+		/**
+		 * Resamples one column of cells from an input grid (BILINEAR or CONSERVATIVE).
+		 *
+		 * @param i_outsideZero cells outside of the grid get the value zero,
+		 *        otherwise the values at the edge of the grid are extended.
+		 */
+		void resampleColumn(const InputGrid &i_grid, InputGrid::TileRef &io_tile, bool i_outsideZero,
+				float x, float originY, float dx, float dy, int count, float *o_values) const {
+			const int nX = i_grid.getNX();
+			const int nY = i_grid.getNY();
+
+			if (resampling == BILINEAR) {
+				const float fx = (x - i_grid.getMinX()) / i_grid.getDX();
+				if (i_outsideZero && (fx < 0 || fx > nX - 1)) {
+					std::fill(o_values, o_values + count, 0.f);
+					return;
+				}
+				const int i0 = std::min(std::max((int) std::floor(fx), 0), nX - 2);
+				const float tx = std::min(std::max(fx - i0, 0.f), 1.f);
+
+				for (int i = 0; i < count; i++) {
+					const float fy = (originY + (i + .5f) * dy - i_grid.getMinY()) / i_grid.getDY();
+					if (i_outsideZero && (fy < 0 || fy > nY - 1)) {
+						o_values[i] = 0;
+						continue;
+					}
+					const int j0 = std::min(std::max((int) std::floor(fy), 0), nY - 2);
+					const float ty = std::min(std::max(fy - j0, 0.f), 1.f);
+					const float bottom = (1 - tx) * i_grid.at(i0, j0, io_tile) + tx * i_grid.at(i0 + 1, j0, io_tile);
+					const float top = (1 - tx) * i_grid.at(i0, j0 + 1, io_tile) + tx * i_grid.at(i0 + 1, j0 + 1, io_tile);
+					o_values[i] = (1 - ty) * bottom + ty * top;
+				}
+				return;
+			}
+
+			std::vector<int> indexX, indexY;
+			std::vector<float> weightX, weightY;
+			const float normX = getOverlap(x - .5f * dx, x + .5f * dx, i_grid.getMinX(), i_grid.getDX(), nX,
+					i_outsideZero, indexX, weightX);
+			getOverlap(originY, originY + count * dy, i_grid.getMinY(), i_grid.getDY(), nY, false, indexY, weightY);
+			if (indexX.empty()) {
+				std::fill(o_values, o_values + count, 0.f);
+				return;
+			}
+
+			// Average all input rows touched by the column in x-direction once
+			const int firstRow = indexY.front();
+			std::vector<float> rows(indexY.back() - firstRow + 1, 0.f);
+			for (size_t k = 0; k < indexX.size(); k++)
+				for (size_t r = 0; r < rows.size(); r++)
+					rows[r] += weightX[k] * i_grid.at(indexX[k], firstRow + r, io_tile);
+
+			for (int i = 0; i < count; i++) {
+				const float y = originY + (i + .5f) * dy;
+				const float normY = getOverlap(y - .5f * dy, y + .5f * dy, i_grid.getMinY(), i_grid.getDY(), nY,
+						i_outsideZero, indexY, weightY);
+				float sum = 0;
+				for (size_t k = 0; k < indexY.size(); k++)
+					sum += weightY[k] * rows[indexY[k] - firstRow];
+				o_values[i] = sum / (normX * normY);
+			}
+		}
+
+		std::string bathymetryFilename;
+		// Selected level of the bathymetry pyramid
+		std::string levelFilename;
+		Resampling resampling;
+		// Domain of the original bathymetry
+		float bathymetryRange[4];
+
+		InputGrid bathymetryGrid;
+		InputGrid displacementGrid;
+};
+#endif // __SWE_NETCDFSCENARIO_HH
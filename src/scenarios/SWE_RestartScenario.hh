@@ -0,0 +1,68 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * Domain and boundaries of a restarted simulation.
+ *
+ * A restarted run reads the unknowns and the bathymetry from the restart
+ * files, so it does not need the input files of the original scenario.
+ * This scenario only provides what the restart files store about it.
+ */
+
+#ifndef __SWE_RESTART_SCENARIO_HH
+#define __SWE_RESTART_SCENARIO_HH
+
+#include "SWE_Scenario.hh"
+#include "tools/RestartFile.hh"
+
+class SWE_RestartScenario : public SWE_Scenario {
+	private:
+		float boundaryPos[4];
+		BoundaryType boundaryTypes[4];
+
+	public:
+		SWE_RestartScenario(const RestartFile::Header &i_header) {
+			for (int i = 0; i < 4; i++) {
+				boundaryPos[i] = i_header.domain[i];
+				boundaryTypes[i] = static_cast<BoundaryType>(i_header.boundaryTypes[i]);
+			}
+		}
+
+		/**
+		 * Stores the domain and the boundaries of a scenario in a restart header
+		 */
+		static void storeDomain(SWE_Scenario &i_scenario, RestartFile::Header &o_header) {
+			for (int i = 0; i < 4; i++) {
+				o_header.domain[i] = i_scenario.getBoundaryPos(static_cast<Boundary>(i));
+				o_header.boundaryTypes[i] = i_scenario.getBoundaryType(static_cast<Boundary>(i));
+			}
+		}
+
+		BoundaryType getBoundaryType(Boundary boundary) {
+			return boundaryTypes[boundary];
+		}
+
+		float getBoundaryPos(Boundary boundary) {
+			return boundaryPos[boundary];
+		}
+};
+
+#endif // __SWE_RESTART_SCENARIO_HH
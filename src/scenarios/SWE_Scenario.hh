@@ -46,6 +46,59 @@ class SWE_Scenario {
 		virtual float getBathymetry(float x, float y) { return 0; }
 		virtual float getVeloc_u(float x, float y) { return 0; }
 		virtual float getVeloc_v(float x, float y) { return 0; }
+
+		/**
+		 * Part of getBathymetry() which is not static, e.g. the displacement
+		 * of the sea floor by an earthquake.
+		 */
+		virtual float getDisplacement(float x, float y) { return 0; }
+
+		/**
+		 * Displacement of the sea floor at a point in time, e.g. during a rupture.
+		 * At time 0 it has to match getDisplacement().
+		 */
+		virtual float getDynamicDisplacement(float x, float y, float time) { return getDisplacement(x, y); }
+
+		/**
+		 * Checks whether the displacement changes between two points in time.
+		 *
+		 * @param o_region bounding box [minX, maxX, minY, maxY] of all points
+		 *                 at which the displacement changes.
+		 * @return false if the displacement is the same at time0 and time1.
+		 */
+		virtual bool getDisplacementChange(float time0, float time1, float o_region[4]) { return false; }
+
+		/**
+		 * Samples all unknowns at the cell centers of one grid column.
+		 *
+		 * Cell i of the column is centered at (x, originY + (i + 1/2) * dy).
+		 * The default implementation queries the point functions above,
+		 * scenarios with expensive lookups should override it and share the
+		 * lookups of one cell between the unknowns.
+		 * initScenario() samples the columns in parallel (OpenMP), so this
+		 * function must be safe to call concurrently.
+		 *
+		 * @param x x-coordinate of the column (cell centers).
+		 * @param originY y-coordinate of the bottom edge of the column.
+		 * @param dx cell width.
+		 * @param dy cell height.
+		 * @param count number of cells in the column.
+		 * @param o_b bathymetry.
+		 * @param o_h water height.
+		 * @param o_hu momentum in x-direction (h * u).
+		 * @param o_hv momentum in y-direction (h * v).
+		 */
+		virtual void getColumn(float x, float originY, float dx, float dy, int count,
+				float *o_b, float *o_h, float *o_hu, float *o_hv) {
+			for (int i = 0; i < count; i++) {
+				const float y = originY + (i + 0.5) * dy;
+				o_b[i] = getBathymetry(x, y);
+				o_h[i] = getWaterHeight(x, y);
+				o_hu[i] = getVeloc_u(x, y) * o_h[i];
+				o_hv[i] = getVeloc_v(x, y) * o_h[i];
+			}
+		}
+
 		virtual BoundaryType getBoundaryType(Boundary boundary) { return OUTFLOW; }
 		virtual float getBoundaryPos(Boundary boundary) {
 			if (boundary == BND_LEFT || boundary == BND_BOTTOM)
@@ -0,0 +1,260 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * Binary file with the bathymetry already sampled on a simulation grid.
+ *
+ * The file starts with a Header, followed (at byte dataOffset) by square tiles
+ * of tileSize x tileSize cells. Tiles are ordered by x, then by y. Cells within
+ * a tile are ordered by x, then by y, like the columns of a Float2D. Tiles at
+ * the upper and right edges of the grid are padded.
+ * The file is mapped into memory, so a block only reads the pages of its tiles.
+ *
+ * The header is written last. A file which was not completely written is
+ * therefore treated as a miss, like a file for a different grid or input.
+ * The input is identified by the name, the size and the modification time
+ * of the sampled bathymetry file and by the way it is sampled.
+ */
+
+#ifndef BATHYMETRYCACHE_HH_
+#define BATHYMETRYCACHE_HH_
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdint.h>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+class BathymetryCache {
+	public:
+		/** Number of cells in each direction of a tile */
+		static const int tileSize = 64;
+		/** First byte of the tiles (keeps the tiles page aligned) */
+		static const size_t dataOffset = 4096;
+
+		/** Grid of the cached bathymetry */
+		struct Header {
+			//! "SWEBATH" + format version
+			char magic[8];
+			int32_t nX, nY;
+			int32_t tileSize;
+			//! Sampling of the input (e.g. SWE_NetCdfScenario::Resampling)
+			int32_t sampling;
+			float originX, originY;
+			float dX, dY;
+			//! Hash of the name, size and modification time of the input
+			uint64_t inputId;
+		};
+
+		/**
+		 * @param i_inputFileName bathymetry file which is sampled.
+		 * @param i_sampling how the input is sampled, a cache of another sampling is a miss.
+		 * @param i_nX number of cells of the whole grid in x-direction.
+		 * @param i_nY number of cells of the whole grid in y-direction.
+		 * @param i_originX x-coordinate of the lower left corner of the grid.
+		 * @param i_originY y-coordinate of the lower left corner of the grid.
+		 */
+		BathymetryCache(const std::string &i_fileName,
+				const std::string &i_inputFileName,
+				int i_sampling,
+				int i_nX, int i_nY,
+				float i_originX, float i_originY,
+				float i_dX, float i_dY) :
+			fileName(i_fileName),
+			tilesX((i_nX + tileSize - 1) / tileSize),
+			tilesY((i_nY + tileSize - 1) / tileSize),
+			file(-1), mapping(0) {
+			memset(&header, 0, sizeof(header));
+			memcpy(header.magic, "SWEBATH\2", sizeof(header.magic));
+			header.nX = i_nX;
+			header.nY = i_nY;
+			header.tileSize = tileSize;
+			header.sampling = i_sampling;
+			header.originX = i_originX;
+			header.originY = i_originY;
+			header.dX = i_dX;
+			header.dY = i_dY;
+			header.inputId = getInputId(i_inputFileName);
+
+			fileSize = dataOffset + static_cast<size_t>(tilesX) * tilesY * tileSize * tileSize * sizeof(float);
+		}
+
+		~BathymetryCache() {
+			if (mapping)
+				munmap(mapping, fileSize);
+			if (file >= 0)
+				close(file);
+		}
+
+		/**
+		 * Maps the cache file.
+		 *
+		 * @return false if the file does not exist or belongs to another grid
+		 */
+		bool map() {
+			int cache = open(fileName.c_str(), O_RDONLY);
+			if (cache < 0)
+				return false;
+
+			struct stat status;
+			Header fileHeader;
+			if (fstat(cache, &status) != 0
+					|| static_cast<size_t>(status.st_size) != fileSize
+					|| pread(cache, &fileHeader, sizeof(fileHeader), 0) != sizeof(fileHeader)
+					|| memcmp(&fileHeader, &header, sizeof(header)) != 0) {
+				close(cache);
+				return false;
+			}
+
+			void *data = mmap(0, fileSize, PROT_READ, MAP_SHARED, cache, 0);
+			close(cache);
+			if (data == MAP_FAILED)
+				return false;
+
+			mapping = static_cast<char*>(data);
+			return true;
+		}
+
+		/**
+		 * Copies the cells [i_firstY, i_firstY + i_count) of column i_x from the mapped file
+		 */
+		void readColumn(int i_x, int i_firstY, int i_count, float *o_b) const {
+			assert(mapping);
+			assert(i_x >= 0 && i_x < header.nX);
+			assert(i_firstY >= 0 && i_firstY + i_count <= header.nY);
+
+			for (int y = i_firstY; y < i_firstY + i_count; ) {
+				const int count = std::min(i_firstY + i_count, (y / tileSize + 1) * tileSize) - y;
+				memcpy(o_b, mapping + getOffset(i_x, y), count * sizeof(float));
+				o_b += count;
+				y += count;
+			}
+		}
+
+		/**
+		 * Stores the cells [i_firstY, i_firstY + i_count) of column i_x.
+		 *
+		 * Several processes can write different cells of the same file.
+		 */
+		void writeColumn(int i_x, int i_firstY, int i_count, const float *i_b) {
+			assert(i_x >= 0 && i_x < header.nX);
+			assert(i_firstY >= 0 && i_firstY + i_count <= header.nY);
+
+			if (!openForWriting())
+				return;
+
+			for (int y = i_firstY; y < i_firstY + i_count; ) {
+				const int count = std::min(i_firstY + i_count, (y / tileSize + 1) * tileSize) - y;
+				if (pwrite(file, i_b, count * sizeof(float), getOffset(i_x, y)) != static_cast<ssize_t>(count * sizeof(float)))
+					std::cerr << "Could not write " << fileName << ": " << strerror(errno) << std::endl;
+				i_b += count;
+				y += count;
+			}
+		}
+
+		/**
+		 * Finishes writing the cells of this process
+		 */
+		void flush() {
+			if (file < 0)
+				return;
+
+			if (fsync(file) != 0)
+				std::cerr << "Could not write " << fileName << ": " << strerror(errno) << std::endl;
+			close(file);
+			file = -1;
+		}
+
+		/**
+		 * Makes the file valid, must be called by a single process
+		 * once all processes have flushed their cells
+		 */
+		void commit() {
+			if (!openForWriting())
+				return;
+
+			if (fsync(file) != 0
+					|| pwrite(file, &header, sizeof(header), 0) != sizeof(header))
+				std::cerr << "Could not write " << fileName << ": " << strerror(errno) << std::endl;
+			flush();
+		}
+
+	private:
+		static uint64_t getInputId(const std::string &i_fileName) {
+			struct stat status;
+			int64_t properties[2] = {-1, -1};
+			if (stat(i_fileName.c_str(), &status) == 0) {
+				properties[0] = status.st_size;
+				properties[1] = status.st_mtime;
+			}
+
+			uint64_t hash = 14695981039346656037ull;
+			for (size_t i = 0; i < i_fileName.size(); i++)
+				hash = (hash ^ static_cast<unsigned char>(i_fileName[i])) * 1099511628211ull;
+			const unsigned char *bytes = reinterpret_cast<const unsigned char*>(properties);
+			for (size_t i = 0; i < sizeof(properties); i++)
+				hash = (hash ^ bytes[i]) * 1099511628211ull;
+			return hash;
+		}
+
+		bool openForWriting() {
+			if (file >= 0)
+				return true;
+
+			file = open(fileName.c_str(), O_RDWR | O_CREAT, 0644);
+			// All processes resize the file to the same size
+			if (file < 0 || ftruncate(file, fileSize) != 0) {
+				std::cerr << "Could not create " << fileName << ": " << strerror(errno) << std::endl;
+				if (file >= 0)
+					close(file);
+				file = -1;
+				return false;
+			}
+			return true;
+		}
+
+		//! @return position of cell (x, y) in the file
+		size_t getOffset(int x, int y) const {
+			const size_t tile = static_cast<size_t>(x / tileSize) * tilesY + y / tileSize;
+			return dataOffset
+					+ (tile * tileSize * tileSize + (x % tileSize) * tileSize + y % tileSize) * sizeof(float);
+		}
+
+		std::string fileName;
+		Header header;
+
+		int tilesX, tilesY;
+		size_t fileSize;
+
+		/** File descriptor while writing */
+		int file;
+		/** Mapped file while reading */
+		char *mapping;
+};
+
+#endif // BATHYMETRYCACHE_HH_
@@ -0,0 +1,18 @@
+#ifndef __FLOAT2DVIEW_HH
+#define __FLOAT2DVIEW_HH
+
+#include "tools/Float2D.hh"
+
+/**
+ * Grid over memory owned by someone else (e.g. a message), nothing is copied or freed.
+ */
+class Float2DView : public Float2D {
+	public:
+		Float2DView(int cols, int rows, float *data) :
+				Float2D(cols, rows) {
+			rawData = data;
+		}
+
+		~Float2DView() {}
+};
+#endif // FLOAT2DVIEW_HH
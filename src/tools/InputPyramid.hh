@@ -0,0 +1,303 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * Coarsened copies of a netCDF input grid, used by simulations with cells
+ * much larger than the spacing of the input.
+ *
+ * Level k of <name>.nc is stored in <name>_level<k>.nc, in the same layout
+ * as the input (a 2D variable with the dimensions (y, x) and 1D coordinate
+ * variables). Each level has twice the spacing of the previous one. Its
+ * points are every second point of the previous level, smoothed with the
+ * filter (1/4, 1/2, 1/4) in each direction. A level has one point more than
+ * needed if the previous one has an even number of points, so every level
+ * covers the whole input.
+ *
+ * The levels are built row by row, only three rows of the previous level are
+ * kept in memory.
+ */
+
+#ifndef INPUTPYRAMID_HH_
+#define INPUTPYRAMID_HH_
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#ifdef USEMPI
+#include <mpi.h>
+#ifndef MPI_INCLUDED
+#define MPI_INCLUDED
+#define MPI_INCLUDED_NETCDF
+#endif
+#endif
+#include <netcdf.h>
+#ifdef MPI_INCLUDED_NETCDF
+#undef MPI_INCLUDED
+#undef MPI_INCLUDED_NETCDF
+#endif
+
+class InputPyramid {
+	public:
+		/**
+		 * @return the name of the file with level i_level (0 = the input itself)
+		 */
+		static std::string getLevelName(const std::string &i_fileName, int i_level) {
+			if (i_level == 0)
+				return i_fileName;
+
+			const size_t extension = i_fileName.rfind('.');
+			const size_t directory = i_fileName.rfind('/');
+			const size_t end = (extension != std::string::npos
+					&& (directory == std::string::npos || extension > directory)) ? extension : i_fileName.size();
+
+			std::ostringstream name;
+			name << i_fileName.substr(0, end) << "_level" << i_level << i_fileName.substr(end);
+			return name.str();
+		}
+
+		/**
+		 * Builds the levels 1 to i_levels, stops early if a level would have less than two points
+		 * in a direction.
+		 *
+		 * @return false if a level could not be built
+		 */
+		static bool build(const std::string &i_fileName, int i_levels) {
+			for (int level = 1; level <= i_levels; level++) {
+				const int status = coarsen(getLevelName(i_fileName, level - 1), getLevelName(i_fileName, level));
+				if (status == NC_EINVAL)
+					break;
+				if (status != NC_NOERR) {
+					std::cerr << "Could not build " << getLevelName(i_fileName, level) << ": "
+							<< nc_strerror(status) << std::endl;
+					return false;
+				}
+				std::cout << "Built " << getLevelName(i_fileName, level) << std::endl;
+			}
+			return true;
+		}
+
+		/**
+		 * @param i_dX cell width of the simulation.
+		 * @param i_dY cell height of the simulation.
+		 * @return the file of the coarsest existing level with a spacing no larger than
+		 *         the cells of the simulation
+		 */
+		static std::string select(const std::string &i_fileName, float i_dX, float i_dY) {
+			std::string selected = i_fileName;
+			for (int level = 1; ; level++) {
+				const std::string levelName = getLevelName(i_fileName, level);
+
+				int file;
+				if (nc_open(levelName.c_str(), NC_NOWRITE, &file) != NC_NOERR)
+					break;
+				Grid grid;
+				const int status = grid.read(file);
+				nc_close(file);
+
+				// Allow for rounding errors in the coordinates
+				if (status != NC_NOERR
+						|| grid.getSpacing(grid.x) > i_dX * 1.0001f
+						|| grid.getSpacing(grid.y) > i_dY * 1.0001f)
+					break;
+				selected = levelName;
+			}
+			return selected;
+		}
+
+	private:
+		/**
+		 * Variable and coordinates of an input file
+		 */
+		struct Grid {
+			int var;
+			int dims[2];
+			std::string dimNames[2];
+			//! Coordinates of the points
+			std::vector<double> y, x;
+
+			int read(int i_file) {
+				int status = nc_inq_varid(i_file, "z", &var);
+				if (status != NC_NOERR) {
+					// The first 2D variable
+					int varCount;
+					status = nc_inq_nvars(i_file, &varCount);
+					for (var = 0; var < varCount && status == NC_NOERR; var++) {
+						int dimCount;
+						status = nc_inq_varndims(i_file, var, &dimCount);
+						if (dimCount == 2)
+							break;
+					}
+					if (status == NC_NOERR && var == varCount)
+						status = NC_ENOTVAR;
+				}
+				if (status == NC_NOERR)
+					status = nc_inq_vardimid(i_file, var, dims);
+				if (status == NC_NOERR)
+					status = readCoordinates(i_file, dims[0], dimNames[0], y);
+				if (status == NC_NOERR)
+					status = readCoordinates(i_file, dims[1], dimNames[1], x);
+				return status;
+			}
+
+			static double getSpacing(const std::vector<double> &i_coordinates) {
+				return (i_coordinates.back() - i_coordinates.front()) / (i_coordinates.size() - 1);
+			}
+
+			static int readCoordinates(int i_file, int i_dim, std::string &o_name, std::vector<double> &o_coordinates) {
+				char name[NC_MAX_NAME + 1];
+				size_t n;
+				int status = nc_inq_dim(i_file, i_dim, name, &n);
+				if (status != NC_NOERR)
+					return status;
+				if (n < 2)
+					return NC_EINVAL;
+				o_name = name;
+
+				int coordinates;
+				status = nc_inq_varid(i_file, name, &coordinates);
+				if (status != NC_NOERR)
+					return status;
+				o_coordinates.resize(n);
+				return nc_get_var_double(i_file, coordinates, o_coordinates.data());
+			}
+		};
+
+		/**
+		 * Writes the next level of i_source to i_target.
+		 *
+		 * @return NC_EINVAL if the source has too few points
+		 */
+		static int coarsen(const std::string &i_source, const std::string &i_target) {
+			int source;
+			int status = nc_open(i_source.c_str(), NC_NOWRITE, &source);
+			if (status != NC_NOERR)
+				return status;
+
+			Grid fine;
+			status = fine.read(source);
+			if (status == NC_NOERR && (fine.x.size() < 3 || fine.y.size() < 3))
+				status = NC_EINVAL;
+			if (status != NC_NOERR) {
+				nc_close(source);
+				return status;
+			}
+
+			// Every second point, one more to cover the last point of an even count
+			const size_t nX = fine.x.size() / 2 + 1;
+			const size_t nY = fine.y.size() / 2 + 1;
+			std::vector<double> x(nX), y(nY);
+			for (size_t i = 0; i < nX; i++)
+				x[i] = fine.x.front() + 2 * i * Grid::getSpacing(fine.x);
+			for (size_t j = 0; j < nY; j++)
+				y[j] = fine.y.front() + 2 * j * Grid::getSpacing(fine.y);
+
+			// The level is complete once it is renamed
+			const std::string temporaryName = i_target + ".tmp";
+			int target;
+			status = nc_create(temporaryName.c_str(), NC_CLOBBER | NC_64BIT_OFFSET, &target);
+			if (status != NC_NOERR) {
+				nc_close(source);
+				return status;
+			}
+
+			int dims[2], xVar, yVar, var;
+			status = nc_def_dim(target, fine.dimNames[0].c_str(), nY, &dims[0]);
+			if (status == NC_NOERR)
+				status = nc_def_dim(target, fine.dimNames[1].c_str(), nX, &dims[1]);
+			if (status == NC_NOERR)
+				status = nc_def_var(target, fine.dimNames[0].c_str(), NC_DOUBLE, 1, &dims[0], &yVar);
+			if (status == NC_NOERR)
+				status = nc_def_var(target, fine.dimNames[1].c_str(), NC_DOUBLE, 1, &dims[1], &xVar);
+			char name[NC_MAX_NAME + 1];
+			if (status == NC_NOERR)
+				status = nc_inq_varname(source, fine.var, name);
+			if (status == NC_NOERR)
+				status = nc_def_var(target, name, NC_FLOAT, 2, dims, &var);
+			if (status == NC_NOERR)
+				status = nc_enddef(target);
+			if (status == NC_NOERR)
+				status = nc_put_var_double(target, yVar, y.data());
+			if (status == NC_NOERR)
+				status = nc_put_var_double(target, xVar, x.data());
+
+			// Rows 2j - 1, 2j and 2j + 1 of the previous level
+			std::vector<float> rows[3];
+			for (int r = 0; r < 3; r++)
+				rows[r].resize(fine.x.size());
+			std::vector<float> row(nX);
+			for (size_t j = 0; j < nY && status == NC_NOERR; j++) {
+				float weights[3] = {.25f, .5f, .25f};
+				for (int r = 0; r < 3 && status == NC_NOERR; r++) {
+					const long fineY = 2 * static_cast<long>(j) - 1 + r;
+					if (fineY < 0 || fineY >= static_cast<long>(fine.y.size())) {
+						weights[r] = 0;
+						continue;
+					}
+					// The last row of the previous step is the first one of this step
+					if (r == 0 && j > 0) {
+						rows[0].swap(rows[2]);
+						continue;
+					}
+
+					size_t start[2] = {static_cast<size_t>(fineY), 0};
+					size_t count[2] = {1, fine.x.size()};
+					status = nc_get_vara_float(source, fine.var, start, count, rows[r].data());
+				}
+
+				for (size_t i = 0; i < nX; i++) {
+					float sum = 0, weightSum = 0;
+					for (int r = 0; r < 3; r++) {
+						if (weights[r] == 0)
+							continue;
+						for (int c = 0; c < 3; c++) {
+							const long fineX = 2 * static_cast<long>(i) - 1 + c;
+							if (fineX < 0 || fineX >= static_cast<long>(fine.x.size()))
+								continue;
+							const float weight = weights[r] * ((c == 1) ? .5f : .25f);
+							sum += weight * rows[r][fineX];
+							weightSum += weight;
+						}
+					}
+					row[i] = sum / weightSum;
+				}
+
+				size_t start[2] = {j, 0};
+				size_t count[2] = {1, nX};
+				if (status == NC_NOERR)
+					status = nc_put_vara_float(target, var, start, count, row.data());
+			}
+
+			nc_close(source);
+			const int closed = nc_close(target);
+			if (status == NC_NOERR)
+				status = closed;
+			if (status == NC_NOERR && rename(temporaryName.c_str(), i_target.c_str()) != 0)
+				status = NC_EPERM;
+			if (status != NC_NOERR)
+				remove(temporaryName.c_str());
+			return status;
+		}
+};
+
+#endif // INPUTPYRAMID_HH_
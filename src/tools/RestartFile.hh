@@ -0,0 +1,405 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * Binary files with the complete state of one block, used to resume a simulation.
+ *
+ * A full restart file starts with a Header, which describes the block, its
+ * position in the decomposition and the progress of the simulation. It is
+ * followed by b, h, hu and hv including the ghost layers, each with
+ * (nX + 2) * (nY + 2) values in the column-major order of Float2D. Every block
+ * writes its own files.
+ *
+ * Between two full files, only the tiles (tileSize x tileSize values of one
+ * grid) which changed since the previous restart file are written to the
+ * increments <name>.1, <name>.2, ... Changes are detected by a checksum of
+ * every tile. An increment starts with a Header as well, followed by
+ * tileCount tiles, each with a TileHeader and the values of the tile
+ * (column by column, clipped at the upper and right edges).
+ *
+ * Every file is written under a temporary name and renamed once it is complete,
+ * a failure while writing therefore keeps the previous restart files.
+ */
+
+#ifndef RESTARTFILE_HH_
+#define RESTARTFILE_HH_
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+class RestartFile {
+	public:
+		/** Number of stored grids (b, h, hu, hv) */
+		static const int fieldCount = 4;
+		/** Number of values in each direction of a tile of an increment */
+		static const int tileSize = 64;
+
+		/** Block and progress of the simulation */
+		struct Header {
+			//! "SWERST" + format version
+			char magic[8];
+			int32_t nX, nY;
+			//! Position of the block and number of blocks in each direction
+			int32_t blockPositionX, blockPositionY;
+			int32_t blockCountX, blockCountY;
+			//! Number of checkpoints (output snapshots) already reached
+			int32_t checkpoint;
+			//! Checkpoint of the full file an increment is based on (= checkpoint for a full file)
+			int32_t fullCheckpoint;
+			uint64_t iteration;
+			float time;
+			float originX, originY;
+			float dX, dY;
+			//! Domain of the whole simulation (left, right, bottom, top) and its boundary types
+			float domain[4];
+			int32_t boundaryTypes[4];
+			//! Number of tiles in an increment
+			int32_t tileCount;
+		};
+
+		/** Position of a tile in an increment */
+		struct TileHeader {
+			int32_t field;
+			int32_t tile;
+		};
+
+		/**
+		 * @param i_fullInterval every n-th restart file written by write() contains
+		 *        the complete state, the others are increments (1 = only full files).
+		 */
+		RestartFile(const std::string &i_fileName, unsigned int i_fullInterval = 1) :
+			fileName(i_fileName),
+			fullInterval(std::max(i_fullInterval, 1u)),
+			fullCheckpoint(-1),
+			increments(0) {
+		}
+
+		const std::string& getFileName() const {
+			return fileName;
+		}
+
+		/**
+		 * Writes a full file or an increment against the previously written file.
+		 *
+		 * @param i_fields b, h, hu and hv.
+		 * @return false if the file could not be written
+		 */
+		bool write(const Header &i_header, const float* const i_fields[fieldCount]) {
+			Header header = i_header;
+			const int tiles = getTileCount(header);
+			std::vector<uint64_t> newChecksums(fieldCount * tiles);
+			for (int i = 0; i < fieldCount * tiles; i++)
+				newChecksums[i] = checksum(header, i_fields[i / tiles], i % tiles);
+
+			const bool full = fullCheckpoint < 0
+					|| increments + 1 >= fullInterval
+					|| newChecksums.size() != checksums.size();
+
+			bool written;
+			if (full) {
+				header.fullCheckpoint = header.checkpoint;
+				header.tileCount = 0;
+				written = writeFile(fileName, header, i_fields, std::vector<int>());
+			} else {
+				std::vector<int> changed;
+				for (size_t i = 0; i < newChecksums.size(); i++)
+					if (newChecksums[i] != checksums[i])
+						changed.push_back(i);
+				header.fullCheckpoint = fullCheckpoint;
+				header.tileCount = changed.size();
+				written = writeFile(getIncrementName(increments + 1), header, i_fields, changed);
+			}
+
+			if (!written) {
+				// The next file is a full one again
+				fullCheckpoint = -1;
+				return false;
+			}
+
+			if (full) {
+				// The increments of the previous full file (possibly from an earlier run) are obsolete
+				for (int i = 1; remove(getIncrementName(i).c_str()) == 0; i++)
+					;
+				fullCheckpoint = header.checkpoint;
+				increments = 0;
+			} else
+				increments++;
+			checksums.swap(newChecksums);
+			return true;
+		}
+
+		/**
+		 * Reads the header of the full file, e.g. to set up the grid before the state is read.
+		 *
+		 * @return false if the file does not exist
+		 */
+		bool readHeader(Header &o_header) const {
+			FILE *file = openFile(fileName, -1, -1, o_header);
+			if (!file)
+				return false;
+			fclose(file);
+			return true;
+		}
+
+		/**
+		 * Reads the full file and applies all of its increments.
+		 *
+		 * @param i_nX number of cells of the block in x-direction (without the ghost layers).
+		 * @param i_nY number of cells of the block in y-direction.
+		 * @param o_header header of the last applied file.
+		 * @param o_fields b, h, hu and hv.
+		 * @return false if the files do not exist or belong to a block of another size
+		 */
+		bool read(int i_nX, int i_nY, Header &o_header, float* const o_fields[fieldCount]) const {
+			FILE *file = openFile(fileName, i_nX, i_nY, o_header);
+			if (!file)
+				return false;
+
+			if (o_header.fullCheckpoint != o_header.checkpoint) {
+				std::cerr << fileName << " is an increment" << std::endl;
+				fclose(file);
+				return false;
+			}
+
+			const size_t size = getFieldSize(o_header);
+			bool valid = true;
+			for (int i = 0; i < fieldCount && valid; i++)
+				valid = fread(o_fields[i], sizeof(float), size, file) == size;
+			fclose(file);
+			if (!valid) {
+				std::cerr << fileName << " is incomplete" << std::endl;
+				return false;
+			}
+
+			for (int i = 1; ; i++) {
+				const std::string incrementName = getIncrementName(i);
+				Header increment;
+				file = openFile(incrementName, i_nX, i_nY, increment, false);
+				if (!file)
+					break;
+				// Left over from an earlier sequence
+				if (increment.fullCheckpoint != o_header.fullCheckpoint
+						|| increment.checkpoint <= o_header.checkpoint) {
+					fclose(file);
+					break;
+				}
+
+				valid = true;
+				for (int j = 0; j < increment.tileCount && valid; j++)
+					valid = readTile(file, increment, o_fields);
+				fclose(file);
+				if (!valid) {
+					std::cerr << incrementName << " is incomplete" << std::endl;
+					return false;
+				}
+				o_header = increment;
+			}
+
+			return true;
+		}
+
+		/**
+		 * Merges the full file and its increments into a new full file.
+		 *
+		 * @return false if the files could not be read or written
+		 */
+		bool compact() {
+			Header header;
+			if (!readHeader(header))
+				return false;
+
+			std::vector<float> data(fieldCount * getFieldSize(header));
+			float* const fields[fieldCount] = {
+				&data[0], &data[getFieldSize(header)], &data[2 * getFieldSize(header)], &data[3 * getFieldSize(header)]
+			};
+			if (!read(header.nX, header.nY, header, fields))
+				return false;
+
+			fullCheckpoint = -1;
+			return write(header, fields);
+		}
+
+		//! @return number of values of each grid (including the ghost layers)
+		static size_t getFieldSize(const Header &i_header) {
+			return static_cast<size_t>(i_header.nX + 2) * (i_header.nY + 2);
+		}
+
+	private:
+		static const char* magic() {
+			return "SWERST\3";
+		}
+
+		std::string getIncrementName(int i_increment) const {
+			std::ostringstream name;
+			name << fileName << '.' << i_increment;
+			return name.str();
+		}
+
+		static int getTilesY(const Header &i_header) {
+			return (i_header.nY + 2 + tileSize - 1) / tileSize;
+		}
+
+		static int getTileCount(const Header &i_header) {
+			return (i_header.nX + 2 + tileSize - 1) / tileSize * getTilesY(i_header);
+		}
+
+		/**
+		 * Range of the values of a tile
+		 */
+		static void getTileRange(const Header &i_header, int i_tile,
+				int &o_firstX, int &o_lastX, int &o_firstY, int &o_lastY) {
+			o_firstX = i_tile / getTilesY(i_header) * tileSize;
+			o_firstY = i_tile % getTilesY(i_header) * tileSize;
+			o_lastX = std::min(o_firstX + tileSize, i_header.nX + 2);
+			o_lastY = std::min(o_firstY + tileSize, i_header.nY + 2);
+		}
+
+		/**
+		 * @return FNV-1a hash of the values of a tile
+		 */
+		static uint64_t checksum(const Header &i_header, const float *i_field, int i_tile) {
+			int firstX, lastX, firstY, lastY;
+			getTileRange(i_header, i_tile, firstX, lastX, firstY, lastY);
+
+			uint64_t hash = 14695981039346656037ull;
+			for (int x = firstX; x < lastX; x++) {
+				const unsigned char *bytes = reinterpret_cast<const unsigned char*>(
+						i_field + static_cast<size_t>(x) * (i_header.nY + 2) + firstY);
+				for (size_t i = 0; i < (lastY - firstY) * sizeof(float); i++)
+					hash = (hash ^ bytes[i]) * 1099511628211ull;
+			}
+			return hash;
+		}
+
+		/**
+		 * @param i_tiles tiles (field * tile count + tile) of an increment, empty for a full file
+		 */
+		bool writeFile(const std::string &i_fileName, Header header,
+				const float* const i_fields[fieldCount], const std::vector<int> &i_tiles) const {
+			memcpy(header.magic, magic(), sizeof(header.magic));
+
+			const std::string temporaryName = i_fileName + ".tmp";
+			FILE *file = fopen(temporaryName.c_str(), "wb");
+			if (!file) {
+				std::cerr << "Could not create " << temporaryName << ": " << strerror(errno) << std::endl;
+				return false;
+			}
+
+			bool written = fwrite(&header, sizeof(header), 1, file) == 1;
+			if (header.fullCheckpoint == header.checkpoint) {
+				const size_t size = getFieldSize(header);
+				for (int i = 0; i < fieldCount && written; i++)
+					written = fwrite(i_fields[i], sizeof(float), size, file) == size;
+			} else {
+				const int tiles = getTileCount(header);
+				for (size_t i = 0; i < i_tiles.size() && written; i++) {
+					const TileHeader tile = {i_tiles[i] / tiles, i_tiles[i] % tiles};
+					written = writeTile(file, header, tile, i_fields[tile.field]);
+				}
+			}
+			// The data has to be on disk before the old file is replaced
+			written = written && fflush(file) == 0 && fsync(fileno(file)) == 0;
+			written = (fclose(file) == 0) && written;
+
+			if (!written || rename(temporaryName.c_str(), i_fileName.c_str()) != 0) {
+				std::cerr << "Could not write " << i_fileName << ": " << strerror(errno) << std::endl;
+				remove(temporaryName.c_str());
+				return false;
+			}
+			return true;
+		}
+
+		static bool writeTile(FILE *file, const Header &i_header, const TileHeader &i_tile, const float *i_field) {
+			int firstX, lastX, firstY, lastY;
+			getTileRange(i_header, i_tile.tile, firstX, lastX, firstY, lastY);
+
+			if (fwrite(&i_tile, sizeof(i_tile), 1, file) != 1)
+				return false;
+			const size_t count = lastY - firstY;
+			for (int x = firstX; x < lastX; x++)
+				if (fwrite(i_field + static_cast<size_t>(x) * (i_header.nY + 2) + firstY, sizeof(float), count, file) != count)
+					return false;
+			return true;
+		}
+
+		static bool readTile(FILE *file, const Header &i_header, float* const o_fields[fieldCount]) {
+			TileHeader tile;
+			if (fread(&tile, sizeof(tile), 1, file) != 1
+					|| tile.field < 0 || tile.field >= fieldCount
+					|| tile.tile < 0 || tile.tile >= getTileCount(i_header))
+				return false;
+
+			int firstX, lastX, firstY, lastY;
+			getTileRange(i_header, tile.tile, firstX, lastX, firstY, lastY);
+			const size_t count = lastY - firstY;
+			for (int x = firstX; x < lastX; x++)
+				if (fread(o_fields[tile.field] + static_cast<size_t>(x) * (i_header.nY + 2) + firstY, sizeof(float), count, file) != count)
+					return false;
+			return true;
+		}
+
+		/**
+		 * Opens a restart file and reads its header.
+		 *
+		 * @param i_nX expected size of the block, -1 accepts any size.
+		 * @param i_required print an error message if the file does not exist
+		 * @return the file positioned after the header, NULL on failure
+		 */
+		static FILE* openFile(const std::string &i_fileName, int i_nX, int i_nY,
+				Header &o_header, bool i_required = true) {
+			FILE *file = fopen(i_fileName.c_str(), "rb");
+			if (!file) {
+				if (i_required)
+					std::cerr << "Could not open " << i_fileName << ": " << strerror(errno) << std::endl;
+				return 0;
+			}
+
+			if (fread(&o_header, sizeof(o_header), 1, file) != 1
+					|| memcmp(o_header.magic, magic(), sizeof(o_header.magic)) != 0
+					|| (i_nX >= 0 && (o_header.nX != i_nX || o_header.nY != i_nY))) {
+				std::cerr << i_fileName << " is not a restart file of this block" << std::endl;
+				fclose(file);
+				return 0;
+			}
+			return file;
+		}
+
+		std::string fileName;
+
+		unsigned int fullInterval;
+		/** Checkpoint of the last full file written by this process, -1 if none */
+		int fullCheckpoint;
+		/** Number of increments written since the last full file */
+		unsigned int increments;
+		/** Checksums of all tiles of the last written file */
+		std::vector<uint64_t> checksums;
+};
+
+#endif // RESTARTFILE_HH_
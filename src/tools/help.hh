@@ -107,11 +107,13 @@ std::string generateBaseFileName(std::string &i_baseName, int i_blockPositionX ,
 /**
  * generate output filename for the ParaView-Container-File
  * (to visualize multiple SWE_Blocks per checkpoint)
+ *
+ * Uses the same numbering as the files of the single blocks (<base>.<timestep>.vts).
  */
-inline std::string generateContainerFileName(std::string baseName, int timeStep) {
+inline std::string generateContainerFileName(const std::string &baseName, int timeStep) {
 
 	std::ostringstream FileName;
-	FileName << baseName<<"_"<<timeStep<<".pvts";
+	FileName << baseName<<"."<<timeStep<<".pvts";
 	return FileName.str();
 };
 
@@ -0,0 +1,113 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AsyncWriter.hh"
+
+#include <algorithm>
+#include <cassert>
+
+/**
+ * @param i_writer writer doing the actual output, has to outlive the decorator
+ *   and must not be used by anyone else meanwhile.
+ * @param i_queueDepth number of snapshots which can be queued before
+ *   writeTimeStep() blocks (2 = double buffering).
+ */
+AsyncWriter::AsyncWriter(Writer &i_writer, unsigned int i_queueDepth) :
+	Writer(i_writer),
+	writer(i_writer),
+	queueDepth(std::max(i_queueDepth, 1u)),
+	finished(false),
+	thread(&AsyncWriter::run, this)
+{
+}
+
+/**
+ * Writes all queued snapshots and stops the background thread.
+ */
+AsyncWriter::~AsyncWriter() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		finished = true;
+	}
+	snapshotQueued.notify_one();
+	thread.join();
+}
+
+/**
+ * Copies the unknowns into a free staging buffer and queues them.
+ * If all buffers are queued, the caller waits until the oldest one was written (back-pressure).
+ */
+void AsyncWriter::writeTimeStep(const Float2D &i_h,
+		const Float2D &i_hu,
+		const Float2D &i_hv,
+		float i_time) {
+
+	std::unique_lock<std::mutex> lock(mutex);
+
+	if (snapshots.empty()) {
+		// The background thread does not touch the buffers before they are queued
+		snapshots.resize(queueDepth);
+		for (unsigned int i = 0; i < queueDepth; i++) {
+			snapshots[i].h = Float2DNative(i_h.getCols(), i_h.getRows());
+			snapshots[i].hu = Float2DNative(i_hu.getCols(), i_hu.getRows());
+			snapshots[i].hv = Float2DNative(i_hv.getCols(), i_hv.getRows());
+			available.push_back(&snapshots[i]);
+		}
+	}
+
+	snapshotWritten.wait(lock, [this] { return !available.empty(); });
+	Snapshot *snapshot = available.back();
+	available.pop_back();
+	lock.unlock();
+
+	// Copy without holding the lock, the background thread may write meanwhile
+	int size = i_h.getCols() * i_h.getRows();
+	assert(snapshot->h.getCols() * snapshot->h.getRows() == size);
+	std::copy(i_h.getRawPointer(), i_h.getRawPointer() + size, snapshot->h.getRawPointer());
+	std::copy(i_hu.getRawPointer(), i_hu.getRawPointer() + size, snapshot->hu.getRawPointer());
+	std::copy(i_hv.getRawPointer(), i_hv.getRawPointer() + size, snapshot->hv.getRawPointer());
+	snapshot->time = i_time;
+
+	lock.lock();
+	pending.push_back(snapshot);
+	timeStep++;
+	lock.unlock();
+	snapshotQueued.notify_one();
+}
+
+void AsyncWriter::run() {
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		snapshotQueued.wait(lock, [this] { return finished || !pending.empty(); });
+		if (pending.empty())
+			// finished and nothing left to write
+			break;
+
+		Snapshot *snapshot = pending.front();
+		pending.pop_front();
+		lock.unlock();
+
+		writer.writeTimeStep(snapshot->h, snapshot->hu, snapshot->hv, snapshot->time);
+
+		lock.lock();
+		available.push_back(snapshot);
+		snapshotWritten.notify_one();
+	}
+}
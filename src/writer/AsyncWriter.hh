@@ -0,0 +1,81 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * Decorator which hands snapshots to another writer running in a background thread.
+ *
+ * Only the unknowns are copied; the bathymetry is read by the background thread,
+ * so the sea floor must not move (SConstruct rejects dynamicDisplacement).
+ */
+
+#ifndef ASYNCWRITER_HH_
+#define ASYNCWRITER_HH_
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "writer/Writer.hh"
+#include "tools/Float2DNative.hh"
+
+class AsyncWriter : public Writer {
+	public:
+		AsyncWriter(Writer &i_writer, unsigned int i_queueDepth = 2);
+		virtual ~AsyncWriter();
+
+		// copies the unknowns and returns, blocks only if the queue is full.
+		void writeTimeStep(const Float2D &i_h,
+				const Float2D &i_hu,
+				const Float2D &i_hv,
+				float i_time);
+
+	private:
+		/** Copy of the unknowns (including the boundary) */
+		struct Snapshot {
+			Float2DNative h, hu, hv;
+			float time;
+		};
+
+		// writes queued snapshots until the writer is destroyed.
+		void run();
+
+		/** The writer doing the actual output, only used by the background thread */
+		Writer &writer;
+
+		/** Staging buffers, allocated with the first snapshot */
+		std::vector<Snapshot> snapshots;
+		unsigned int queueDepth;
+
+		/** Snapshots waiting to be written, in order */
+		std::deque<Snapshot*> pending;
+		/** Snapshots which can be reused */
+		std::vector<Snapshot*> available;
+		bool finished;
+
+		std::mutex mutex;
+		std::condition_variable snapshotQueued;
+		std::condition_variable snapshotWritten;
+
+		std::thread thread;
+};
+#endif // ASYNCWRITER_HH_
@@ -0,0 +1,52 @@
+#include "CheckpointWriterCharm.hh"
+#include "tools/Float2DView.hh"
+
+#include <algorithm>
+#include <cassert>
+
+CheckpointWriterCharm::CheckpointWriterCharm(CkMigrateMessage *msg) :
+		writer(NULL) {}
+
+CheckpointWriterCharm::CheckpointWriterCharm(int nx, int ny, float dx, float dy, float originX, float originY, std::string outputFilename) :
+		nx(nx), ny(ny),
+		dx(dx), dy(dy),
+		originX(originX), originY(originY),
+		outputFilename(outputFilename),
+		writer(NULL),
+		// Same layout as the grids of the block, including ghost layers
+		b(nx + 2, ny + 2),
+		writeTimeWall(0.) {
+}
+
+CheckpointWriterCharm::~CheckpointWriterCharm() {
+	delete writer;
+}
+
+void CheckpointWriterCharm::writeSnapshot(snapshot *msg) {
+	struct timespec startTime;
+	struct timespec endTime;
+	clock_gettime(CLOCK_MONOTONIC, &startTime);
+
+	// The unknowns are written directly from the message
+	Float2DView h(nx + 2, ny + 2, msg->h);
+	Float2DView hu(nx + 2, ny + 2, msg->hu);
+	Float2DView hv(nx + 2, ny + 2, msg->hv);
+
+	if (writer == NULL) {
+		// The bathymetry is static and only part of the first snapshot, the writer keeps a reference
+		assert(CkGetRefNum(msg) == 0);
+		std::copy(msg->b, msg->b + (nx + 2) * (ny + 2), b.getRawPointer());
+
+		BoundarySize boundarySize = {{1, 1, 1, 1}};
+		writer = new NetCdfWriter(outputFilename, b, boundarySize, nx, ny, dx, dy, originX, originY);
+	}
+	writer->writeTimeStep(h, hu, hv, msg->time);
+
+	delete msg;
+
+	clock_gettime(CLOCK_MONOTONIC, &endTime);
+	writeTimeWall += (endTime.tv_sec - startTime.tv_sec);
+	writeTimeWall += (float) (endTime.tv_nsec - startTime.tv_nsec) / 1E9;
+}
+
+#include "CheckpointWriterCharm.def.h"
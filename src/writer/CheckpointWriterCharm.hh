@@ -0,0 +1,62 @@
+#ifndef CHECKPOINTWRITERCHARM_HH
+#define CHECKPOINTWRITERCHARM_HH
+
+#include "CheckpointWriterCharm.decl.h"
+
+#include <ctime>
+#include <time.h>
+#include <string>
+#include "examples/swe_charm.decl.h"
+#include "writer/NetCdfWriter.hh"
+#include "tools/Float2DNative.hh"
+
+extern CProxy_swe_charm mainProxy;
+extern int checkpointCount;
+
+/**
+ * Writes the checkpoints of one simulation block.
+ *
+ * The block copies its grids into a snapshot message and continues stepping,
+ * the (synchronous) netCDF output is done here. Writer elements are usually
+ * placed on PEs which are not used by simulation blocks.
+ */
+class CheckpointWriterCharm : public CBase_CheckpointWriterCharm {
+
+	CheckpointWriterCharm_SDAG_CODE
+
+	public:
+		// Charm++ specific constructor needed for object migration
+		CheckpointWriterCharm(CkMigrateMessage *msg);
+		CheckpointWriterCharm(int nx, int ny, float dx, float dy, float originX, float originY, std::string outputFilename);
+		~CheckpointWriterCharm();
+
+	private:
+		void writeSnapshot(snapshot *msg);
+
+		int nx, ny;
+		float dx, dy;
+		float originX, originY;
+		std::string outputFilename;
+
+		// Created with the first snapshot, which carries the bathymetry
+		NetCdfWriter *writer;
+
+		// Bathymetry of the first snapshot, referenced by the writer
+		Float2DNative b;
+
+		// Loop counter of the SDAG code
+		int writtenSnapshots;
+
+		float writeTimeWall;
+};
+
+class snapshot : public CMessage_snapshot {
+	public:
+		float time;
+		float *h;
+		float *hu;
+		float *hv;
+		float *b;
+};
+
+#endif // CHECKPOINTWRITERCHARM_HH
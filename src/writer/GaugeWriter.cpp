@@ -0,0 +1,242 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GaugeWriter.hh"
+
+#include <cassert>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+/**
+ * Finds the gauges located in this block.
+ *
+ * @param i_gauges all gauges, the same list on all ranks.
+ * @param i_blockOffsetX first cell of the block in x-direction.
+ * @param i_blockOffsetY first cell of the block in y-direction.
+ * @param i_flushInterval number of time steps buffered before they are written.
+ */
+GaugeWriter::GaugeWriter(const std::string &i_fileName,
+		const std::vector<Gauge> &i_gauges,
+		const BoundarySize &i_boundarySize,
+		float i_originX, float i_originY,
+		float i_dX, float i_dY,
+		int i_blockOffsetX, int i_blockOffsetY,
+		int i_nX, int i_nY,
+		unsigned int i_flushInterval
+#ifdef USEMPI
+		, MPI_Comm i_comm
+#endif
+		) :
+	fileName(i_fileName),
+	gauges(i_gauges),
+	flushInterval(std::max(i_flushInterval, 1u)),
+	started(false)
+#ifdef USEMPI
+	, comm(i_comm)
+#endif
+{
+	for (size_t i = 0; i < gauges.size(); i++) {
+		// A gauge on the edge between two cells belongs to the upper/right cell
+		const int x = std::floor((gauges[i].x - i_originX) / i_dX) - i_blockOffsetX;
+		const int y = std::floor((gauges[i].y - i_originY) / i_dY) - i_blockOffsetY;
+		if (x < 0 || x >= i_nX || y < 0 || y >= i_nY)
+			continue;
+
+		localGauges.push_back(i);
+		localX.push_back(x + i_boundarySize[0]);
+		localY.push_back(y + i_boundarySize[2]);
+	}
+
+	times.reserve(flushInterval);
+	values.reserve(flushInterval * localGauges.size() * 3);
+
+#ifdef USEMPI
+	// The first rank needs to know where the values of each gauge come from
+	MPI_Comm_rank(comm, &rank);
+	int size;
+	MPI_Comm_size(comm, &size);
+
+	int localCount = localGauges.size();
+	std::vector<int> displacements;
+	if (rank == 0) {
+		gaugeCounts.resize(size);
+		displacements.resize(size);
+	}
+	MPI_Gather(&localCount, 1, MPI_INT, gaugeCounts.data(), 1, MPI_INT, 0, comm);
+	if (rank == 0) {
+		int owners = 0;
+		for (int r = 0; r < size; r++) {
+			displacements[r] = owners;
+			owners += gaugeCounts[r];
+		}
+		gaugeOwners.resize(owners);
+	}
+	MPI_Gatherv(localGauges.data(), localCount, MPI_INT,
+			gaugeOwners.data(), gaugeCounts.data(), displacements.data(), MPI_INT, 0, comm);
+
+	if (rank == 0 && gaugeOwners.size() < gauges.size())
+		std::cerr << gauges.size() - gaugeOwners.size() << " gauges are outside of the domain" << std::endl;
+#else
+	if (localGauges.size() < gauges.size())
+		std::cerr << gauges.size() - localGauges.size() << " gauges are outside of the domain" << std::endl;
+#endif
+}
+
+/**
+ * Writes the remaining records (collective with MPI)
+ */
+GaugeWriter::~GaugeWriter()
+{
+	flush();
+}
+
+/**
+ * Buffers the unknowns of the local gauges, the buffer is written every
+ * flushInterval time steps.
+ * With MPI, all ranks have to call this for every time step.
+ */
+void GaugeWriter::record(const Float2D &i_h,
+		const Float2D &i_hu,
+		const Float2D &i_hv,
+		float i_time)
+{
+	times.push_back(i_time);
+	for (size_t i = 0; i < localGauges.size(); i++) {
+		values.push_back(i_h[localX[i]][localY[i]]);
+		values.push_back(i_hu[localX[i]][localY[i]]);
+		values.push_back(i_hv[localX[i]][localY[i]]);
+	}
+
+	if (times.size() >= flushInterval)
+		flush();
+}
+
+void GaugeWriter::flush()
+{
+	const size_t records = times.size();
+	if (records == 0)
+		return;
+
+#ifdef USEMPI
+	// Collect the buffers of all ranks, ordered by rank
+	std::vector<float> allValues;
+	std::vector<int> receiveCounts;
+	std::vector<int> displacements;
+	if (rank == 0) {
+		receiveCounts.resize(gaugeCounts.size());
+		displacements.resize(gaugeCounts.size());
+		int total = 0;
+		for (size_t r = 0; r < gaugeCounts.size(); r++) {
+			receiveCounts[r] = records * 3 * gaugeCounts[r];
+			displacements[r] = total;
+			total += receiveCounts[r];
+		}
+		allValues.resize(total);
+	}
+	MPI_Gatherv(values.data(), values.size(), MPI_FLOAT,
+			allValues.data(), receiveCounts.data(), displacements.data(), MPI_FLOAT, 0, comm);
+
+	if (rank != 0) {
+		times.clear();
+		values.clear();
+		return;
+	}
+
+	const std::vector<int> &counts = gaugeCounts;
+	const std::vector<int> &owners = gaugeOwners;
+#else
+	const std::vector<float> &allValues = values;
+	const std::vector<int> counts(1, localGauges.size());
+	const std::vector<int> &owners = localGauges;
+#endif
+
+	// Reopen the table for every flush, the file is never kept open during the simulation
+	FILE *table = fopen(fileName.c_str(), started ? "a" : "w");
+	if (!table) {
+		std::cerr << "Could not open " << fileName << ": " << strerror(errno) << std::endl;
+		assert(false);
+		return;
+	}
+
+	if (!started) {
+		fprintf(table, "# SWE gauge time series, nan for gauges outside of the domain\n");
+		for (size_t i = 0; i < gauges.size(); i++)
+			fprintf(table, "# gauge %lu: x = %.7g, y = %.7g\n", (unsigned long) i, gauges[i].x, gauges[i].y);
+		fprintf(table, "# time");
+		for (size_t i = 0; i < gauges.size(); i++)
+			fprintf(table, " h_%lu hu_%lu hv_%lu", (unsigned long) i, (unsigned long) i, (unsigned long) i);
+		fprintf(table, "\n");
+		started = true;
+	}
+
+	std::vector<float> row(gauges.size() * 3, NAN);
+	for (size_t k = 0; k < records; k++) {
+		// Sort the values of the record into the columns of their gauges
+		const float *block = allValues.data();
+		const int *owner = owners.data();
+		for (size_t r = 0; r < counts.size(); r++) {
+			const float *record = block + k * 3 * counts[r];
+			for (int j = 0; j < counts[r]; j++)
+				std::copy(record + j*3, record + j*3 + 3, &row[owner[j] * 3]);
+			block += records * 3 * counts[r];
+			owner += counts[r];
+		}
+
+		fprintf(table, "%.7g", times[k]);
+		for (size_t i = 0; i < row.size(); i++)
+			fprintf(table, " %.7g", row[i]);
+		fprintf(table, "\n");
+	}
+
+	fclose(table);
+
+	times.clear();
+	values.clear();
+}
+
+/**
+ * Reads gauge locations from a text file with one "x y" (or "x,y") pair per line.
+ * Empty lines and lines starting with '#' are ignored.
+ *
+ * @return false if the file could not be read or contains invalid lines.
+ */
+bool GaugeWriter::readGauges(const std::string &i_fileName, std::vector<Gauge> &o_gauges)
+{
+	std::ifstream file(i_fileName.c_str());
+	if (!file)
+		return false;
+
+	std::string line;
+	while (std::getline(file, line)) {
+		const size_t first = line.find_first_not_of(" \t\r");
+		if (first == std::string::npos || line[first] == '#')
+			continue;
+
+		Gauge gauge;
+		if (sscanf(line.c_str(), "%f%*[ ,\t]%f", &gauge.x, &gauge.y) != 2)
+			return false;
+		o_gauges.push_back(gauge);
+	}
+	return true;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * Records time series of the unknowns at gauge locations (virtual buoys).
+ *
+ * The unknowns of the cells containing the gauges are recorded after every
+ * time step and buffered in memory. Every flushInterval records the buffer is
+ * appended to a single text table with one row per time step:
+ *   time h_0 hu_0 hv_0 h_1 hu_1 hv_1 ...
+ * The columns are ordered like the gauges in the input list. With MPI all ranks
+ * must record and flush collectively, the first rank writes the table.
+ */
+
+#ifndef GAUGEWRITER_HH_
+#define GAUGEWRITER_HH_
+
+#include <string>
+#include <vector>
+#ifdef USEMPI
+#include <mpi.h>
+#endif
+
+#include "tools/Float2D.hh"
+#include "writer/Writer.hh"
+
+class GaugeWriter {
+	public:
+		/** Location of a gauge in domain coordinates */
+		struct Gauge {
+			float x, y;
+		};
+
+		GaugeWriter(const std::string &i_fileName,
+				const std::vector<Gauge> &i_gauges,
+				const BoundarySize &i_boundarySize,
+				float i_originX, float i_originY,
+				float i_dX, float i_dY,
+				int i_blockOffsetX, int i_blockOffsetY,
+				int i_nX, int i_nY,
+				unsigned int i_flushInterval = 100
+#ifdef USEMPI
+				, MPI_Comm i_comm = MPI_COMM_WORLD
+#endif
+				);
+		~GaugeWriter();
+
+		// records the unknowns of all gauges in this block
+		void record(const Float2D &i_h,
+				const Float2D &i_hu,
+				const Float2D &i_hv,
+				float i_time);
+
+		// appends all buffered records to the table
+		void flush();
+
+		// reads gauge locations from a file
+		static bool readGauges(const std::string &i_fileName, std::vector<Gauge> &o_gauges);
+
+	private:
+		/** Name of the table */
+		std::string fileName;
+
+		/** All gauges (the first rank needs them for the header) */
+		std::vector<Gauge> gauges;
+
+		/** Index (in gauges) of the gauges in this block */
+		std::vector<int> localGauges;
+		/** Cells (including the ghost layer) of the local gauges */
+		std::vector<int> localX, localY;
+
+		/** Records are written after this many time steps */
+		unsigned int flushInterval;
+
+		/** Times of the buffered records */
+		std::vector<float> times;
+		/** Buffered h, hu and hv of the local gauges, one record after the other */
+		std::vector<float> values;
+
+		/** True once the table header is written */
+		bool started;
+
+#ifdef USEMPI
+		/** All ranks recording gauges */
+		MPI_Comm comm;
+		int rank;
+
+		/** Number of local gauges and gauge indices of all ranks (first rank only) */
+		std::vector<int> gaugeCounts;
+		std::vector<int> gaugeOwners;
+#endif
+};
+
+#endif // GAUGEWRITER_HH_
@@ -29,8 +29,15 @@
 #include "NetCdfWriter.hh"
 #include <string>
 #include <vector>
+#include <algorithm>
 #include <iostream>
 #include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <stdint.h>
+#include <sys/stat.h>
 
 /**
  * Create a netCdf-file
@@ -44,6 +51,7 @@
  * @param i_originX
  * @param i_originY
  * @param i_flush If > 0, flush data to disk every i_flush write operation
+ * @param i_options chunking, compression and reporting
  * @param i_dynamicBathymetry
  */
 NetCdfWriter::NetCdfWriter( const std::string &i_baseName,
@@ -52,10 +60,18 @@ NetCdfWriter::NetCdfWriter( const std::string &i_baseName,
 		int i_nX, int i_nY,
 		float i_dX, float i_dY,
 		float i_originX, float i_originY,
-		unsigned int i_flush) :
+		unsigned int i_flush,
+		const Options &i_options) :
 	//const bool  &i_dynamicBathymetry) : //!TODO
 	Writer(i_baseName + ".nc", i_b, i_boundarySize, i_nX, i_nY),
-	flush(i_flush)
+	flush(i_flush),
+	buffer(i_nX * i_nY),
+	offsetX(0), offsetY(0),
+	parallel(false),
+	globalNX(i_nX), globalNY(i_nY),
+	options(i_options),
+	reportedFileSize(0),
+	writesTime(true)
 {
 	int status;
 
@@ -69,6 +85,91 @@ NetCdfWriter::NetCdfWriter( const std::string &i_baseName,
 		return;
 	}
 
+	defineFile(nX, nY, i_dX, i_dY, i_originX, i_originY);
+}
+
+#ifdef NETCDF_PARALLEL
+/**
+ * Create a netCdf-file shared by all blocks (processes) of a communicator using parallel netCDF-4 (MPI-IO).
+ * Every process writes the hyperslab of its block into the global variables.
+ * Any existing file will be replaced.
+ *
+ * @param i_baseName base name of the netCDF-file, has to be the same on all processes.
+ * @param i_nX number of cells of the local block in the horizontal direction.
+ * @param i_nY number of cells of the local block in the vertical direction.
+ * @param i_dX cell size in x-direction.
+ * @param i_dY cell size in y-direction.
+ * @param i_originX origin of the local block.
+ * @param i_originY origin of the local block.
+ * @param i_globalNX number of cells of the whole domain in the horizontal direction.
+ * @param i_globalNY number of cells of the whole domain in the vertical direction.
+ * @param i_offsetX index of the first cell of the local block in the whole domain.
+ * @param i_offsetY index of the first cell of the local block in the whole domain.
+ * @param i_comm communicator of all processes writing to the file, the constructor is collective.
+ * @param i_info MPI-IO hints (e.g. romio_cb_write to configure collective buffering).
+ * @param i_flush If > 0, flush data to disk every i_flush write operation
+ * @param i_options chunking, compression and reporting (filters require netCDF >= 4.7.4 for parallel files)
+ */
+NetCdfWriter::NetCdfWriter( const std::string &i_baseName,
+		const Float2D &i_b,
+		const BoundarySize &i_boundarySize,
+		int i_nX, int i_nY,
+		float i_dX, float i_dY,
+		float i_originX, float i_originY,
+		int i_globalNX, int i_globalNY,
+		int i_offsetX, int i_offsetY,
+		MPI_Comm i_comm, MPI_Info i_info,
+		unsigned int i_flush,
+		const Options &i_options) :
+	Writer(i_baseName + ".nc", i_b, i_boundarySize, i_nX, i_nY),
+	flush(i_flush),
+	buffer(i_nX * i_nY),
+	offsetX(i_offsetX), offsetY(i_offsetY),
+	parallel(true),
+	globalNX(i_globalNX), globalNY(i_globalNY),
+	options(i_options),
+	reportedFileSize(0),
+	writesTime(false)
+{
+	int status;
+
+	int rank;
+	MPI_Comm_rank(i_comm, &rank);
+	// the time is the same for all blocks
+	writesTime = (rank == 0);
+
+	//create a netCDF-file, an existing file will be replaced
+	status = nc_create_par(fileName.c_str(), NC_NETCDF4 | NC_MPIIO, i_comm, i_info, &dataFile);
+
+	//check if the netCDF-file creation constructor succeeded.
+	if (status != NC_NOERR) {
+		std::cerr << "Could not create " << fileName << ": " << nc_strerror(status) << std::endl;
+		assert(false);
+		return;
+	}
+
+	defineFile(i_globalNX, i_globalNY, i_dX, i_dY, i_originX, i_originY);
+
+	// Growing the unlimited time dimension requires collective access.
+	// Whether the data is actually aggregated by a subset of processes (collective buffering) is up to the MPI-IO hints.
+	nc_var_par_access(dataFile, timeVar, NC_COLLECTIVE);
+	nc_var_par_access(dataFile, bVar, NC_COLLECTIVE);
+}
+#endif
+
+/**
+ * Defines the dimensions, variables and attributes and writes the coordinates of the local block.
+ *
+ * @param i_globalNX size of the x dimension.
+ * @param i_globalNY size of the y dimension.
+ * @param i_dX cell size in x-direction.
+ * @param i_dY cell size in y-direction.
+ * @param i_originX origin of the local block.
+ * @param i_originY origin of the local block.
+ */
+void NetCdfWriter::defineFile(int i_globalNX, int i_globalNY,
+		float i_dX, float i_dY,
+		float i_originX, float i_originY) {
 #ifdef PRINT_NETCDFWRITER_INFORMATION
 	std::cout << "   *** NetCdfWriter::createNetCdfFile" << std::endl;
 	std::cout << "     created/replaced: " << fileName << std::endl;
@@ -78,27 +179,24 @@ NetCdfWriter::NetCdfWriter( const std::string &i_baseName,
 #endif
 
 	//dimensions
-	int l_timeDim, l_xDim, l_yDim;
-	nc_def_dim(dataFile, "time", NC_UNLIMITED, &l_timeDim);
-	nc_def_dim(dataFile, "x", nX, &l_xDim);
-	nc_def_dim(dataFile, "y", nY, &l_yDim);
+	nc_def_dim(dataFile, "time", NC_UNLIMITED, &timeDim);
+	nc_def_dim(dataFile, "x", i_globalNX, &xDim);
+	nc_def_dim(dataFile, "y", i_globalNY, &yDim);
 
 	//variables (TODO: add rest of CF-1.5)
 	int l_xVar, l_yVar;
 
-	nc_def_var(dataFile, "time", NC_FLOAT, 1, &l_timeDim, &timeVar);
+	nc_def_var(dataFile, "time", NC_FLOAT, 1, &timeDim, &timeVar);
 	ncPutAttText(timeVar, "long_name", "Time");
 	ncPutAttText(timeVar, "units", "seconds since simulation start"); // the word "since" is important for the paraview reader
 
-	nc_def_var(dataFile, "x", NC_FLOAT, 1, &l_xDim, &l_xVar);
-	nc_def_var(dataFile, "y", NC_FLOAT, 1, &l_yDim, &l_yVar);
+	nc_def_var(dataFile, "x", NC_FLOAT, 1, &xDim, &l_xVar);
+	nc_def_var(dataFile, "y", NC_FLOAT, 1, &yDim, &l_yVar);
 
-	//variables, fastest changing index is on the right (C syntax), will be mirrored by the library
-	int dims[] = {l_timeDim, l_yDim, l_xDim};
-	nc_def_var(dataFile, "h",  NC_FLOAT, 3, dims, &hVar);
-	nc_def_var(dataFile, "hu", NC_FLOAT, 3, dims, &huVar);
-	nc_def_var(dataFile, "hv", NC_FLOAT, 3, dims, &hvVar);
-	nc_def_var(dataFile, "b",  NC_FLOAT, 2, &dims[1], &bVar);
+	//bathymetry, the time dependent fields are defined with the first time step (see setFields())
+	int dims[] = {yDim, xDim};
+	nc_def_var(dataFile, "b",  NC_FLOAT, 2, dims, &bVar);
+	defineStorage(bVar, false);
 
 	//set attributes to match CF-1.5 convention
 	ncPutAttText(NC_GLOBAL, "Conventions", "CF-1.5");
@@ -109,27 +207,125 @@ NetCdfWriter::NetCdfWriter( const std::string &i_baseName,
 	ncPutAttText(NC_GLOBAL, "references", "http://www5.in.tum.de/SWE");
 	ncPutAttText(NC_GLOBAL, "comment", "SWE is free software and licensed under the GNU General Public License. Remark: In general this does not hold for the used input data.");
 
-	//setup grid size
-	float gridPosition = i_originX + (float).5 * i_dX;
-	for(size_t i = 0; i < nX; i++) {
-		nc_put_var1_float(dataFile, l_xVar, &i, &gridPosition);
+	//setup grid size, one call per coordinate array (the part of the local block)
+	std::vector<float> gridPositions(std::max(nX, nY));
+	for(size_t i = 0; i < nX; i++)
+		gridPositions[i] = i_originX + ((float).5 + i) * i_dX;
+	size_t count = nX;
+	nc_put_vara_float(dataFile, l_xVar, &offsetX, &count, gridPositions.data());
 
-		gridPosition += i_dX;
-	}
+	for(size_t j = 0; j < nY; j++)
+		gridPositions[j] = i_originY + ((float).5 + j) * i_dY;
+	count = nY;
+	nc_put_vara_float(dataFile, l_yVar, &offsetY, &count, gridPositions.data());
+}
+
+/**
+ * Defines a time dependent variable for each selected field.
+ */
+void NetCdfWriter::defineFields() {
+	static const char* const longNames[FIELD_COUNT] = {
+		"water height", "momentum in x-direction", "momentum in y-direction",
+		"surface elevation", "speed", "Froude number"};
 
-	gridPosition = i_originY + (float).5 * i_dY;
-	for(size_t j = 0; j < nY; j++) {
-		nc_put_var1_float(dataFile, l_yVar, &j, &gridPosition);
+	//fastest changing index is on the right (C syntax), will be mirrored by the library
+	int dims[] = {timeDim, yDim, xDim};
+	fieldVars.resize(fields.size());
+	for(size_t i = 0; i < fields.size(); i++) {
+		nc_def_var(dataFile, getFieldName(fields[i]), NC_FLOAT, 3, dims, &fieldVars[i]);
+		ncPutAttText(fieldVars[i], "long_name", longNames[fields[i]]);
+		defineStorage(fieldVars[i], true);
+#ifdef NETCDF_PARALLEL
+		if (parallel)
+			nc_var_par_access(dataFile, fieldVars[i], NC_COLLECTIVE);
+#endif
+	}
+}
 
-		gridPosition += i_dY;
+/**
+ * Sets the chunk shape, the compression filters and the quantization of a variable.
+ * The chunk shape is left to the library unless it was given explicitly.
+ * The bathymetry is compressed as well, but always stored lossless.
+ *
+ * @param i_ncVariable variable id.
+ * @param i_timeDependent is the variable (time, y, x) or (y, x)?
+ */
+void NetCdfWriter::defineStorage(int i_ncVariable, bool i_timeDependent) {
+	if (options.chunked) {
+		size_t chunks[] = {std::max(options.chunkTime, 1u),
+				(options.chunkY > 0) ? std::min<size_t>(options.chunkY, globalNY) : globalNY,
+				(options.chunkX > 0) ? std::min<size_t>(options.chunkX, globalNX) : globalNX};
+		checkStorage(nc_def_var_chunking(dataFile, i_ncVariable, NC_CHUNKED,
+				i_timeDependent ? chunks : &chunks[1]), i_ncVariable, "chunking");
 	}
+
+	if (options.deflateLevel > 0 || options.shuffle)
+		checkStorage(nc_def_var_deflate(dataFile, i_ncVariable, options.shuffle ? 1 : 0,
+				(options.deflateLevel > 0) ? 1 : 0, options.deflateLevel), i_ncVariable, "deflate");
+
+#ifdef NC_QUANTIZE_BITGROOM
+	// Let the library zero the insignificant bits (stored as attribute)
+	if (i_timeDependent && options.significantDigits > 0)
+		checkStorage(nc_def_var_quantize(dataFile, i_ncVariable, NC_QUANTIZE_BITGROOM, options.significantDigits),
+				i_ncVariable, "quantization");
+#endif
+}
+
+/**
+ * Prints a warning if a storage setting was rejected by the library.
+ * The variable is still written, only with the default storage.
+ *
+ * @param i_status status returned by the library.
+ * @param i_ncVariable variable id.
+ * @param i_setting name of the setting.
+ */
+void NetCdfWriter::checkStorage(int i_status, int i_ncVariable, const char* i_setting) {
+	if (i_status == NC_NOERR)
+		return;
+
+	char name[NC_MAX_NAME+1];
+	if (nc_inq_varname(dataFile, i_ncVariable, name) != NC_NOERR)
+		strcpy(name, "?");
+	std::cerr << "NetCdfWriter: could not set " << i_setting << " of " << name
+			<< " in " << fileName << ": " << nc_strerror(i_status) << std::endl;
 }
 
 /**
  * Destructor of a netCDF-writer.
  */
 NetCdfWriter::~NetCdfWriter() {
+	if (dataFile >= 0)
+		nc_close(dataFile);
+}
+
+/**
+ * Closes the netCDF-file without destroying the writer.
+ * Open files can not be moved to another process (e.g. AMPI migration),
+ * no time step may be written before reopen() is called.
+ */
+void NetCdfWriter::close() {
 	nc_close(dataFile);
+	dataFile = -1;
+}
+
+/**
+ * Reopens a netCDF-file closed by close().
+ * The variable ids remain valid, the next time step is appended.
+ *
+ * @return false if the file could not be opened, no time step may be written then.
+ */
+bool NetCdfWriter::reopen() {
+	assert(dataFile < 0);
+	// a shared file would have to be reopened collectively
+	assert(!parallel);
+
+	int status = nc_open(fileName.c_str(), NC_WRITE, &dataFile);
+	if (status != NC_NOERR) {
+		std::cerr << "Could not reopen " << fileName << ": " << nc_strerror(status) << std::endl;
+		dataFile = -1;
+		return false;
+	}
+	return true;
 }
 
 /**
@@ -140,22 +336,25 @@ NetCdfWriter::~NetCdfWriter() {
  * boundarySize[2] == bottom
  * boundarySize[3] == top
  *
- * @param i_matrix array which contains time dependent data.
- * @param i_boundarySize size of the boundaries.
+ * @param i_field the field which is written.
+ * @param i_h water heights.
+ * @param i_hu momentums in x-direction.
+ * @param i_hv momentums in y-direction.
  * @param i_ncVariable time dependent netCDF-variable to which the output is written to.
  */
-void NetCdfWriter::writeVarTimeDependent( const Float2D &i_matrix,
+void NetCdfWriter::writeVarTimeDependent(Field i_field,
+		const Float2D &i_h,
+		const Float2D &i_hu,
+		const Float2D &i_hv,
 		int i_ncVariable ) {
-	//write col wise, necessary to get rid of the boundary
-	//storage in Float2D is col wise
-	//read carefully, the dimensions are confusing
-	size_t start[] = {timeStep, 0, 0};
-	size_t count[] = {1, nY, 1};
-	for(unsigned int col = 0; col < nX; col++) {
-		start[2] = col; //select col (dim "x")
-		nc_put_vara_float(dataFile, i_ncVariable, start, count,
-				&i_matrix[col+boundarySize[0]][boundarySize[2]]); //write col
-	}
+	//compute the field while packing the buffer
+	gatherField(i_field, i_h, i_hu, i_hv, buffer.data());
+	quantize();
+
+	//write the whole interior with a single hyperslab
+	size_t start[] = {timeStep, offsetY, offsetX};
+	size_t count[] = {1, nY, nX};
+	nc_put_vara_float(dataFile, i_ncVariable, start, count, buffer.data());
 }
 
 /**
@@ -172,16 +371,45 @@ void NetCdfWriter::writeVarTimeDependent( const Float2D &i_matrix,
  */
 void NetCdfWriter::writeVarTimeIndependent( const Float2D &i_matrix,
 		int i_ncVariable ) {
-	//write col wise, necessary to get rid of the boundary
-	//storage in Float2D is col wise
-	//read carefully, the dimensions are confusing
-	size_t start[] = {0, 0};
-	size_t count[] = {nY, 1};
-	for(unsigned int col = 0; col < nX; col++) {
-		start[1] = col; //select col (dim "x")
-		nc_put_vara_float(dataFile, i_ncVariable, start, count,
-				&i_matrix[col+boundarySize[0]][boundarySize[2]]); //write col
+	//write the whole interior with a single hyperslab
+	size_t start[] = {offsetY, offsetX};
+	size_t count[] = {nY, nX};
+	nc_put_vara_float(dataFile, i_ncVariable, start, count, gatherInterior(i_matrix));
+}
+
+/**
+ * Copies the interior of a grid (without the boundary) into the contiguous write buffer.
+ *
+ * @param i_matrix grid including the boundary.
+ * @return pointer to nY * nX values in the order of the netCDF variables.
+ */
+const float* NetCdfWriter::gatherInterior(const Float2D &i_matrix) {
+	Writer::gatherInterior(i_matrix, buffer.data());
+	return buffer.data();
+}
+
+/**
+ * Rounds the values in the write buffer to the requested significant digits,
+ * unless the library does it (nc_def_var_quantize).
+ */
+void NetCdfWriter::quantize() {
+#ifndef NC_QUANTIZE_BITGROOM
+	// The library can not quantize, round the mantissa to the bits needed for the significant digits.
+	// Trailing zero bits compress well with shuffle + deflate.
+	if (options.significantDigits > 0) {
+		int keepBits = std::min(23, (int) std::ceil(options.significantDigits * std::log2(10.)) + 1);
+		uint32_t mask = ~((UINT32_C(1) << (23 - keepBits)) - 1);
+		uint32_t half = (keepBits < 23) ? UINT32_C(1) << (22 - keepBits) : 0;
+		for(size_t i = 0; i < buffer.size(); i++) {
+			if (!std::isfinite(buffer[i]))
+				continue;
+			uint32_t bits;
+			std::memcpy(&bits, &buffer[i], sizeof(bits));
+			bits = (bits + half) & mask;
+			std::memcpy(&buffer[i], &bits, sizeof(bits));
+		}
 	}
+#endif
 }
 
 /**
@@ -203,26 +431,97 @@ void NetCdfWriter::writeTimeStep(const Float2D &i_h,
 		const Float2D &i_hv,
 		float i_time) {
 
+	struct timespec startTime;
+	clock_gettime(CLOCK_MONOTONIC, &startTime);
+	size_t bytes = fields.size() * nX * nY * sizeof(float);
+
 	if (timeStep == 0) {
+		defineFields();
+
 		// Write bathymetry
 		writeVarTimeIndependent(b, bVar);
+		bytes += nX * nY * sizeof(float);
 	}
 
-	//write i_time
-	nc_put_var1_float(dataFile, timeVar, &timeStep, &i_time);
+	//write i_time (in a shared file all processes take part, but only one writes)
+	size_t timeCount = writesTime ? 1 : 0;
+	nc_put_vara_float(dataFile, timeVar, &timeStep, &timeCount, &i_time);
 
-	//write water height
-	writeVarTimeDependent(i_h, hVar);
-
-	//write momentum in x-direction
-	writeVarTimeDependent(i_hu, huVar);
-
-	//write momentum in y-direction
-	writeVarTimeDependent(i_hv, hvVar);
+	//write the selected fields (h, hu, hv by default)
+	for(size_t i = 0; i < fields.size(); i++)
+		writeVarTimeDependent(fields[i], i_h, i_hu, i_hv, fieldVars[i]);
 
 	// Increment timeStep for next call
 	timeStep++;
 
-	//if (flush > 0 && timeStep % flush == 0)
+	if ((flush > 0 && timeStep % flush == 0) || options.report)
 		nc_sync(dataFile);
+
+	if (options.report) {
+		struct timespec endTime;
+		clock_gettime(CLOCK_MONOTONIC, &endTime);
+		reportTimeStep((endTime.tv_sec - startTime.tv_sec) + (endTime.tv_nsec - startTime.tv_nsec) / 1E9, bytes);
+	}
+}
+
+/**
+ * Writes the in-situ products of the simulation (see SWE_Block::enableEnvelope())
+ * as time independent variables. They are written once, usually after the last time step.
+ * For a shared file, all processes have to call this method.
+ *
+ * @param i_maxWaveHeight maximum surface elevation.
+ * @param i_maxSpeed maximum particle speed.
+ * @param i_arrivalTime first arrival of the wave, -1 if it never arrived.
+ */
+void NetCdfWriter::writeEnvelope(const Float2D &i_maxWaveHeight,
+		const Float2D &i_maxSpeed,
+		const Float2D &i_arrivalTime) {
+	static const char* const names[] = {"max_eta", "max_speed", "arrival_time"};
+	static const char* const longNames[] = {"maximum surface elevation", "maximum speed", "arrival time"};
+	const Float2D* const products[] = {&i_maxWaveHeight, &i_maxSpeed, &i_arrivalTime};
+
+	int dims[] = {yDim, xDim};
+	int vars[3];
+	for(int i = 0; i < 3; i++) {
+		nc_def_var(dataFile, names[i], NC_FLOAT, 2, dims, &vars[i]);
+		ncPutAttText(vars[i], "long_name", longNames[i]);
+		defineStorage(vars[i], false);
+#ifdef NETCDF_PARALLEL
+		if (parallel)
+			nc_var_par_access(dataFile, vars[i], NC_COLLECTIVE);
+#endif
+	}
+	ncPutAttText(vars[2], "units", "seconds since simulation start");
+	const float notArrived = -1;
+	nc_put_att_float(dataFile, vars[2], "missing_value", NC_FLOAT, 1, &notArrived);
+
+	for(int i = 0; i < 3; i++)
+		writeVarTimeIndependent(*products[i], vars[i]);
+
+	nc_sync(dataFile);
+}
+
+/**
+ * Prints the throughput of this process and the compression ratio (uncompressed size / growth of the file)
+ * of the last snapshot. For a shared file, only the process writing the time reports,
+ * the ratio assumes all processes wrote blocks of the same size.
+ *
+ * @param i_seconds wall time needed to write (and sync) the snapshot.
+ * @param i_bytes uncompressed size of the local data.
+ */
+void NetCdfWriter::reportTimeStep(double i_seconds, size_t i_bytes) {
+	if (!writesTime)
+		return;
+
+	struct stat fileStatus;
+	if (stat(fileName.c_str(), &fileStatus) != 0)
+		return;
+
+	double uncompressed = (double) i_bytes * (globalNX * globalNY) / (nX * nY);
+	double written = fileStatus.st_size - reportedFileSize;
+	reportedFileSize = fileStatus.st_size;
+
+	printf("NetCdfWriter: snapshot %lu of %s: %.2f MB/s, compression ratio %.2f\n",
+			(unsigned long) timeStep - 1, fileName.c_str(),
+			i_bytes / i_seconds / 1E6, (written > 0) ? uncompressed / written : 0.);
 }
@@ -40,6 +40,9 @@
 #endif
 #endif
 #include <netcdf.h>
+#ifdef NETCDF_PARALLEL
+#include <netcdf_par.h>
+#endif
 #ifdef MPI_INCLUDED_NETCDF
 #undef MPI_INCLUDED
 #undef MPI_INCLUDED_NETCDF
@@ -53,13 +56,54 @@ namespace io {
 
 class NetCdfWriter : public Writer {
 	public:
+		/**
+		 * Storage layout of the time dependent variables
+		 */
+		struct Options {
+			/** Set the chunk shape below, otherwise the library chooses it */
+			bool chunked;
+			/** Chunk shape (time, y, x), 0 selects the full dimension */
+			unsigned int chunkTime, chunkY, chunkX;
+			/** Deflate level (0 = no compression, 1-9) */
+			int deflateLevel;
+			/** Apply the shuffle filter before deflating */
+			bool shuffle;
+			/** Number of significant decimal digits kept (lossy), 0 keeps all */
+			int significantDigits;
+			/** Print throughput and compression ratio after each snapshot */
+			bool report;
+
+			Options() :
+				chunked(false),
+				chunkTime(1), chunkY(0), chunkX(0),
+				deflateLevel(0),
+				shuffle(false),
+				significantDigits(0),
+				report(false) {}
+		};
+
 		NetCdfWriter(const std::string &i_fileName,
 				const Float2D &i_b,
 				const BoundarySize &i_boundarySize,
 				int i_nX, int i_nY,
 				float i_dX, float i_dY,
 				float i_originX = 0., float i_originY = 0.,
-				unsigned int i_flush = 0);
+				unsigned int i_flush = 0,
+				const Options &i_options = Options());
+#ifdef NETCDF_PARALLEL
+		// one file for all blocks of the communicator
+		NetCdfWriter(const std::string &i_fileName,
+				const Float2D &i_b,
+				const BoundarySize &i_boundarySize,
+				int i_nX, int i_nY,
+				float i_dX, float i_dY,
+				float i_originX, float i_originY,
+				int i_globalNX, int i_globalNY,
+				int i_offsetX, int i_offsetY,
+				MPI_Comm i_comm, MPI_Info i_info,
+				unsigned int i_flush = 0,
+				const Options &i_options = Options());
+#endif
 		virtual ~NetCdfWriter();
 
 		// writes the unknowns at a given time step to the netCDF-file.
@@ -68,24 +112,88 @@ class NetCdfWriter : public Writer {
 				const Float2D &i_hv,
 				float i_time);
 
+		// writes the maximum wave height, maximum speed and arrival time once.
+		void writeEnvelope(const Float2D &i_maxWaveHeight,
+				const Float2D &i_maxSpeed,
+				const Float2D &i_arrivalTime);
+
+		// closes the file temporarily, e.g. before a migration
+		void close();
+
+		// reopens the file after close()
+		bool reopen();
+
 	private:
 		/** netCDF file id*/
 		int dataFile;
 
+		/** Dimension ids */
+		int timeDim, yDim, xDim;
+
 		/** Variable ids */
-		int timeVar, hVar, huVar, hvVar, bVar;
+		int timeVar, bVar;
+
+		/** Variable ids of the selected fields, defined with the first time step */
+		std::vector<int> fieldVars;
 
 		/** Flush after every x write operation? */
 		unsigned int flush;
 
+		/** Contiguous copy of the interior of a grid, (y, x) like the netCDF variables */
+		std::vector<float> buffer;
+
+		/** Position of the block in the (shared) file */
+		size_t offsetX, offsetY;
+
+		/** Is the file shared by multiple processes? */
+		bool parallel;
+
+		/** Size of the dimensions in the file */
+		size_t globalNX, globalNY;
+
+		/** Chunking, compression and reporting */
+		Options options;
+
+		/** File size after the previous snapshot (for the compression ratio) */
+		long long reportedFileSize;
+
+		/** Does this process write the time variable? */
+		bool writesTime;
+
+		// defines the dimensions and variables, writes the coordinates
+		void defineFile(int i_globalNX, int i_globalNY,
+				float i_dX, float i_dY,
+				float i_originX, float i_originY);
+
+		// defines the variables of the selected fields.
+		void defineFields();
+
 		// writer time dependent variables.
-		void writeVarTimeDependent(const Float2D &i_matrix,
+		void writeVarTimeDependent(Field i_field,
+				const Float2D &i_h,
+				const Float2D &i_hu,
+				const Float2D &i_hv,
 				int i_ncVariable);
 
 		// writes time independent variables.
 		void writeVarTimeIndependent(const Float2D &i_matrix,
 				int i_ncVariable);
 
+		// sets chunking and filters of a variable.
+		void defineStorage(int i_ncVariable, bool i_timeDependent);
+
+		// reports a failed storage setting of a variable.
+		void checkStorage(int i_status, int i_ncVariable, const char* i_setting);
+
+		// copies the interior of a grid into the write buffer.
+		const float* gatherInterior(const Float2D &i_matrix);
+
+		// rounds the write buffer to the requested significant digits.
+		void quantize();
+
+		// prints the throughput and compression ratio of the last snapshot.
+		void reportTimeStep(double i_seconds, size_t i_bytes);
+
 		/**
 		 * This is a small wrapper for `nc_put_att_text` which automatically sets the length.
 		 */
@@ -0,0 +1,149 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * Part of a block which is written by a writer (bounding box and output strides).
+ */
+
+#ifndef OUTPUTREGION_HH_
+#define OUTPUTREGION_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct OutputRegion {
+	//! interior cells [firstX, endX) x [firstY, endY) of the block are written
+	int firstX, endX;
+	int firstY, endY;
+
+	//! number of cells averaged into one output cell in x- and y-direction
+	int strideX, strideY;
+
+	//! first output cell of this block in the output of the whole region
+	int offsetX, offsetY;
+
+	//! first cell of the whole region in the domain
+	int domainFirstX, domainFirstY;
+
+	//! the region is written every interval-th checkpoint
+	unsigned int interval;
+
+	/**
+	 * The whole block in full resolution
+	 */
+	OutputRegion(int i_nX = 0, int i_nY = 0) :
+		firstX(0), endX(i_nX),
+		firstY(0), endY(i_nY),
+		strideX(1), strideY(1),
+		offsetX(0), offsetY(0),
+		domainFirstX(0), domainFirstY(0),
+		interval(1) {}
+
+	//! @return number of output cells in x-direction
+	int getNX() const {
+		return isEmpty() ? 0 : (endX - firstX + strideX - 1) / strideX;
+	}
+
+	//! @return number of output cells in y-direction
+	int getNY() const {
+		return isEmpty() ? 0 : (endY - firstY + strideY - 1) / strideY;
+	}
+
+	//! @return true if the block does not intersect the region
+	bool isEmpty() const {
+		return endX <= firstX || endY <= firstY;
+	}
+
+	/**
+	 * Parses regions of interest and restricts them to a block.
+	 *
+	 * Regions are given as "xmin,xmax,ymin,ymax[,stride[,interval]]" in domain
+	 * coordinates, several regions are separated by ';'. The output cells are
+	 * aligned to the region, not to the block: an output cell belongs to the
+	 * block containing its first cell and averages only the cells of this block.
+	 *
+	 * @param i_regions the regions.
+	 * @param i_originX x-coordinate of the domain origin.
+	 * @param i_originY y-coordinate of the domain origin.
+	 * @param i_dX cell size in x-direction.
+	 * @param i_dY cell size in y-direction.
+	 * @param i_blockOffsetX first cell of the block in x-direction.
+	 * @param i_blockOffsetY first cell of the block in y-direction.
+	 * @param i_nX number of cells of the block in x-direction.
+	 * @param i_nY number of cells of the block in y-direction.
+	 * @param o_regions one (possibly empty) entry per region.
+	 * @return false if the regions could not be parsed.
+	 */
+	static bool parse(const std::string &i_regions,
+			float i_originX, float i_originY,
+			float i_dX, float i_dY,
+			int i_blockOffsetX, int i_blockOffsetY,
+			int i_nX, int i_nY,
+			std::vector<OutputRegion> &o_regions)
+	{
+		std::istringstream regions(i_regions);
+		std::string spec;
+		while (std::getline(regions, spec, ';')) {
+			float minX, maxX, minY, maxY;
+			int stride = 1;
+			unsigned int interval = 1;
+			if (std::sscanf(spec.c_str(), "%f,%f,%f,%f,%d,%u", &minX, &maxX, &minY, &maxY, &stride, &interval) < 4
+					|| stride < 1 || interval < 1)
+				return false;
+
+			OutputRegion region;
+			region.strideX = region.strideY = stride;
+			region.interval = interval;
+			restrict(std::floor((minX - i_originX) / i_dX), std::ceil((maxX - i_originX) / i_dX),
+					i_blockOffsetX, i_nX, stride,
+					region.firstX, region.endX, region.offsetX, region.domainFirstX);
+			restrict(std::floor((minY - i_originY) / i_dY), std::ceil((maxY - i_originY) / i_dY),
+					i_blockOffsetY, i_nY, stride,
+					region.firstY, region.endY, region.offsetY, region.domainFirstY);
+			o_regions.push_back(region);
+		}
+		return true;
+	}
+
+	private:
+		/**
+		 * Intersects the global cells [i_first, i_end) of a region with a block in one direction
+		 */
+		static void restrict(float i_first, float i_end,
+				int i_blockOffset, int i_n, int i_stride,
+				int &o_first, int &o_end, int &o_offset, int &o_domainFirst)
+		{
+			const int first = std::max(0.f, i_first);
+			o_domainFirst = first;
+			const int end = std::min<float>(i_end, i_blockOffset + i_n);
+
+			// First output cell starting inside the block
+			o_offset = std::max(0, (i_blockOffset - first + i_stride - 1) / i_stride);
+			o_first = first + o_offset * i_stride - i_blockOffset;
+			o_end = std::max(o_first, end - i_blockOffset);
+		}
+};
+
+#endif // OUTPUTREGION_HH_
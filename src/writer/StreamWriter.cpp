@@ -0,0 +1,336 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StreamWriter.hh"
+
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/**
+ * Appends all steps to <name>.stream
+ */
+class FileStreamEngine : public StreamEngine {
+	public:
+		FileStreamEngine(const std::string &i_name) :
+			fileName(i_name + ".stream"), file(0), stepSize(0) {}
+
+		~FileStreamEngine() {
+			if (file)
+				fclose(file);
+		}
+
+		void open(const void *i_header, size_t i_headerSize, size_t i_stepSize) {
+			file = fopen(fileName.c_str(), "wb");
+			if (!file) {
+				std::cerr << "Could not create " << fileName << ": " << strerror(errno) << std::endl;
+				assert(false);
+			}
+			stepSize = i_stepSize;
+			fwrite(i_header, 1, i_headerSize, file);
+		}
+
+		void writeStep(const void *i_step) {
+			fwrite(i_step, 1, stepSize, file);
+			// Make the step visible to consumers following the file
+			fflush(file);
+		}
+
+	private:
+		std::string fileName;
+		FILE *file;
+		size_t stepSize;
+};
+
+/**
+ * Sends the steps to a consumer listening on the unix socket <name>.sock
+ *
+ * Only the header is sent blocking. Afterwards the socket is non-blocking:
+ * a step which does not fit into the socket buffer is kept and completed
+ * with the next steps, which are skipped until then. The solver never waits
+ * for the consumer, gaps in StepHeader::timeStep show the skipped steps.
+ * The solver continues without output if the consumer goes away.
+ */
+class SocketStreamEngine : public StreamEngine {
+	public:
+		SocketStreamEngine(const std::string &i_name) :
+			socketName(i_name + ".sock"), connection(-1), stepSize(0),
+			pendingOffset(0), skippedSteps(0) {}
+
+		~SocketStreamEngine() {
+			if (connection >= 0) {
+				// Complete the last step, the consumer expects whole records
+				fcntl(connection, F_SETFL, fcntl(connection, F_GETFL) & ~O_NONBLOCK);
+				sendPending();
+				close(connection);
+			}
+			if (skippedSteps > 0)
+				std::cout << "Stream consumer on " << socketName << " skipped "
+						<< skippedSteps << " steps" << std::endl;
+		}
+
+		void open(const void *i_header, size_t i_headerSize, size_t i_stepSize) {
+			sockaddr_un address;
+			memset(&address, 0, sizeof(address));
+			address.sun_family = AF_UNIX;
+			assert(socketName.size() < sizeof(address.sun_path));
+			strncpy(address.sun_path, socketName.c_str(), sizeof(address.sun_path) - 1);
+
+			connection = socket(AF_UNIX, SOCK_STREAM, 0);
+			if (connection < 0
+					|| connect(connection, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+				std::cerr << "Could not connect to " << socketName << ": " << strerror(errno) << std::endl;
+				assert(false);
+			}
+			stepSize = i_stepSize;
+			pending.reserve(stepSize);
+
+			pending.assign(static_cast<const char*>(i_header), static_cast<const char*>(i_header) + i_headerSize);
+			sendPending();
+			if (connection >= 0)
+				fcntl(connection, F_SETFL, fcntl(connection, F_GETFL) | O_NONBLOCK);
+		}
+
+		void writeStep(const void *i_step) {
+			if (connection < 0)
+				return;
+
+			// Finish the previous step first, skip this one if the consumer is still behind
+			if (!sendPending()) {
+				skippedSteps++;
+				return;
+			}
+
+			// Keep only the part of the step which did not fit into the socket buffer
+			const char *data = static_cast<const char*>(i_step);
+			size_t sent = send(data, stepSize);
+			if (sent < stepSize)
+				pending.assign(data + sent, data + stepSize);
+		}
+
+	private:
+		/**
+		 * Sends as much as possible without blocking (blocks on a blocking socket).
+		 *
+		 * @return number of bytes sent
+		 */
+		size_t send(const char *i_data, size_t i_size) {
+			size_t total = 0;
+			while (connection >= 0 && total < i_size) {
+				ssize_t sent = ::send(connection, i_data + total, i_size - total, MSG_NOSIGNAL);
+				if (sent < 0) {
+					if (errno == EINTR)
+						continue;
+					if (errno == EAGAIN || errno == EWOULDBLOCK)
+						break;
+					std::cerr << "Stream consumer on " << socketName << " disconnected: " << strerror(errno) << std::endl;
+					close(connection);
+					connection = -1;
+					break;
+				}
+				total += sent;
+			}
+			return total;
+		}
+
+		/**
+		 * Continues sending the incomplete step.
+		 *
+		 * @return true if nothing is pending anymore
+		 */
+		bool sendPending() {
+			if (pendingOffset < pending.size())
+				pendingOffset += send(&pending[pendingOffset], pending.size() - pendingOffset);
+			if (pendingOffset < pending.size() && connection >= 0)
+				return false;
+
+			pending.clear();
+			pendingOffset = 0;
+			return true;
+		}
+
+		std::string socketName;
+		int connection;
+		size_t stepSize;
+
+		/** Unsent part of the current record */
+		std::vector<char> pending;
+		size_t pendingOffset;
+
+		/** Steps dropped because the consumer was behind */
+		unsigned long skippedSteps;
+};
+
+/**
+ * Keeps the latest step in the POSIX shared memory object /<name>
+ *
+ * Layout: sequence number (uint64_t), header, step.
+ * The sequence number is odd while a step is written, a consumer copies the
+ * step and retries if the sequence number changed in the meantime.
+ * The solver never waits for the consumer, steps not read in time are lost.
+ *
+ * The object is not removed when the solver finishes, so a consumer which
+ * attaches late still finds the last step. Removing it (shm_unlink) is left
+ * to the consumer, the next run with the same name replaces it.
+ */
+class SharedMemoryStreamEngine : public StreamEngine {
+	public:
+		SharedMemoryStreamEngine(const std::string &i_name) :
+			sequence(0), step(0), stepSize(0), mapping(0), mappingSize(0) {
+			// Shared memory objects must not contain further slashes
+			objectName = '/' + i_name;
+			for (size_t i = 1; i < objectName.size(); i++)
+				if (objectName[i] == '/')
+					objectName[i] = '_';
+		}
+
+		~SharedMemoryStreamEngine() {
+			if (mapping)
+				munmap(mapping, mappingSize);
+		}
+
+		void open(const void *i_header, size_t i_headerSize, size_t i_stepSize) {
+			// Keep the steps aligned
+			const size_t headerSize = (i_headerSize + 7) & ~static_cast<size_t>(7);
+			mappingSize = sizeof(uint64_t) + headerSize + i_stepSize;
+
+			int object = shm_open(objectName.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+			if (object < 0 || ftruncate(object, mappingSize) != 0) {
+				std::cerr << "Could not create shared memory " << objectName << ": " << strerror(errno) << std::endl;
+				assert(false);
+			}
+			mapping = mmap(0, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, object, 0);
+			close(object);
+			assert(mapping != MAP_FAILED);
+
+			sequence = new(mapping) std::atomic<uint64_t>(0);
+			char *header = static_cast<char*>(mapping) + sizeof(uint64_t);
+			memcpy(header, i_header, i_headerSize);
+			step = header + headerSize;
+			stepSize = i_stepSize;
+		}
+
+		void writeStep(const void *i_step) {
+			sequence->fetch_add(1, std::memory_order_acq_rel);
+			memcpy(step, i_step, stepSize);
+			sequence->fetch_add(1, std::memory_order_release);
+		}
+
+	private:
+		std::string objectName;
+		std::atomic<uint64_t> *sequence;
+		char *step;
+		size_t stepSize;
+		void *mapping;
+		size_t mappingSize;
+};
+
+/**
+ * @param i_type file, socket or shm
+ * @param i_name base name of the stream (file name, socket path or shared memory name)
+ * @return the engine or NULL if the type is unknown
+ */
+StreamEngine* StreamEngine::create(const std::string &i_type, const std::string &i_name)
+{
+	if (i_type == "file")
+		return new FileStreamEngine(i_name);
+	if (i_type == "socket")
+		return new SocketStreamEngine(i_name);
+	if (i_type == "shm")
+		return new SharedMemoryStreamEngine(i_name);
+	return 0;
+}
+
+/**
+ * @param i_engine transport of the stream, deleted by the writer.
+ */
+StreamWriter::StreamWriter(const std::string &i_fileName,
+		const Float2D &i_b,
+		const BoundarySize &i_boundarySize,
+		int i_nX, int i_nY,
+		float i_dX, float i_dY,
+		float i_originX, float i_originY,
+		StreamEngine *i_engine) :
+	Writer(i_fileName, i_b, i_boundarySize, i_nX, i_nY),
+	engine(i_engine)
+{
+	assert(engine);
+
+	memcpy(header.magic, "SWESTRM\2", sizeof(header.magic));
+	header.nX = i_nX;
+	header.nY = i_nY;
+	for (int i = 0; i < 4; i++)
+		header.boundarySize[i] = i_boundarySize[i];
+	header.dX = i_dX;
+	header.dY = i_dY;
+	header.originX = i_originX;
+	header.originY = i_originY;
+}
+
+StreamWriter::~StreamWriter()
+{
+	delete engine;
+}
+
+void StreamWriter::writeTimeStep(
+		const Float2D &i_h,
+		const Float2D &i_hu,
+		const Float2D &i_hv,
+		float i_time)
+{
+	const size_t gridSize = nX * nY;
+
+	// The bathymetry is sent once with the header
+	if (timeStep == 0) {
+		header.fieldCount = fields.size();
+		for (int i = 0; i < FIELD_COUNT; i++)
+			header.fields[i] = (i < header.fieldCount) ? fields[i] : -1;
+		step.resize((sizeof(StepHeader) / sizeof(float)) + fields.size() * gridSize);
+
+		std::vector<char> start(sizeof(Header) + gridSize * sizeof(float));
+		memcpy(&start[0], &header, sizeof(Header));
+		gatherInterior(b, reinterpret_cast<float*>(&start[sizeof(Header)]));
+		engine->open(&start[0], start.size(), step.size() * sizeof(float));
+	}
+
+	StepHeader stepHeader;
+	stepHeader.timeStep = timeStep;
+	stepHeader.time = i_time;
+	stepHeader.padding = 0;
+	memcpy(&step[0], &stepHeader, sizeof(StepHeader));
+
+	float *grids = &step[sizeof(StepHeader) / sizeof(float)];
+	for (size_t i = 0; i < fields.size(); i++)
+		gatherField(fields[i], i_h, i_hu, i_hv, grids + i*gridSize);
+
+	engine->writeStep(&step[0]);
+
+	timeStep++;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file
+ * This file is part of SWE.
+ *
+ * @section LICENSE
+ *
+ * SWE is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * SWE is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with SWE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *
+ * @section DESCRIPTION
+ *
+ * Writer which publishes snapshots as a stream of steps through an exchangeable engine.
+ *
+ * Each block produces one stream:
+ *  - a header (StreamWriter::Header) followed by the bathymetry,
+ *  - one record per time step (StreamWriter::StepHeader) followed by the
+ *    selected fields (Header::fields, h, hu and hv by default).
+ * All grids contain only the interior (nY * nX values, x is the fastest index).
+ * Since all records of a stream have the same size, a consumer can seek to any step.
+ */
+
+#ifndef STREAMWRITER_HH_
+#define STREAMWRITER_HH_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "writer/Writer.hh"
+
+/**
+ * Transport of a stream
+ */
+class StreamEngine {
+	public:
+		virtual ~StreamEngine() {}
+
+		/**
+		 * Starts the stream, called once before the first step.
+		 *
+		 * @param i_header header of the stream.
+		 * @param i_headerSize size of the header in bytes.
+		 * @param i_stepSize size of every step in bytes.
+		 */
+		virtual void open(const void *i_header, size_t i_headerSize, size_t i_stepSize) = 0;
+
+		/**
+		 * Publishes one step of the size given in open()
+		 */
+		virtual void writeStep(const void *i_step) = 0;
+
+		// creates one of the built-in engines (file, socket or shm)
+		static StreamEngine* create(const std::string &i_type, const std::string &i_name);
+};
+
+class StreamWriter : public Writer {
+	public:
+		/** Block metadata at the beginning of each stream */
+		struct Header {
+			//! "SWESTRM" + format version
+			char magic[8];
+			int32_t nX, nY;
+			//! left, right, bottom, top
+			int32_t boundarySize[4];
+			float dX, dY;
+			float originX, originY;
+			//! fields in each step (Writer::Field), unused entries are -1
+			int32_t fieldCount;
+			int32_t fields[FIELD_COUNT];
+		};
+
+		/** Beginning of each step */
+		struct StepHeader {
+			uint64_t timeStep;
+			float time;
+			uint32_t padding;
+		};
+
+		StreamWriter(const std::string &i_fileName,
+				const Float2D &i_b,
+				const BoundarySize &i_boundarySize,
+				int i_nX, int i_nY,
+				float i_dX, float i_dY,
+				float i_originX, float i_originY,
+				StreamEngine *i_engine);
+		virtual ~StreamWriter();
+
+		// publishes the unknowns of a time step
+		void writeTimeStep(const Float2D &i_h,
+				const Float2D &i_hu,
+				const Float2D &i_hv,
+				float i_time);
+
+	private:
+		/** Transport of the stream, owned by the writer */
+		StreamEngine *engine;
+
+		/** Block metadata */
+		Header header;
+
+		/** Record of the current step (StepHeader and the fields) */
+		std::vector<float> step;
+};
+
+#endif // STREAMWRITER_HH_
@@ -23,10 +23,30 @@
  * @section DESCRIPTION
  */
 
+#include <algorithm>
 #include <cassert>
+#include <stdint.h>
 #include <fstream>
 #include "VtkWriter.hh"
 
+#ifdef VTK_ZLIB
+#include <zlib.h>
+
+//! additional attribute of the VTKFile element
+static const char* const compressorAttribute = " compressor=\"vtkZLibDataCompressor\"";
+#else
+static const char* const compressorAttribute = "";
+#endif
+
+/**
+ * @return the byte order of this machine as expected by VTK
+ */
+static const char* byteOrder()
+{
+	const uint16_t one = 1;
+	return *reinterpret_cast<const char*>(&one) ? "LittleEndian" : "BigEndian";
+}
+
 /**
  * Creates a vtk file for each time step.
  * Any existing file will be replaced.
@@ -36,22 +56,34 @@
  * @param i_nY number of cells in the vertical direction.
  * @param i_dX cell size in x-direction.
  * @param i_dY cell size in y-direction.
- * @param i_offsetX x-offset of the block
- * @param i_offsetY y-offset of the block
- * @param i_dynamicBathymetry
- *
- * @todo This version can only handle a boundary layer of size 1
+ * @param i_offsetX x-offset of the block (in cells)
+ * @param i_offsetY y-offset of the block (in cells)
+ * @param i_originX x-coordinate of the cell with offset 0 (relative to the domain)
+ * @param i_originY y-coordinate of the cell with offset 0 (relative to the domain)
  */
 VtkWriter::VtkWriter( const std::string &i_baseName,
 		const Float2D &i_b,
 		const BoundarySize &i_boundarySize,
 		int i_nX, int i_nY,
 		float i_dX, float i_dY,
-		int i_offsetX, int i_offsetY) :
+		int i_offsetX, int i_offsetY,
+		float i_originX, float i_originY) :
   Writer(i_baseName, i_b, i_boundarySize, i_nX, i_nY),
   dX(i_dX), dY(i_dY),
-  offsetX(i_offsetX), offsetY(i_offsetY)
+  offsetX(i_offsetX), offsetY(i_offsetY),
+  originX(i_originX), originY(i_originY),
+  buffer(i_nX * i_nY)
 {
+	// Grid points, x is the fastest index
+	std::vector<float> coordinates;
+	coordinates.reserve(3 * (nX+1) * (nY+1));
+	for (unsigned int j = 0; j < nY+1; j++)
+		for (unsigned int i = 0; i < nX+1; i++) {
+			coordinates.push_back(originX + (offsetX+i) * dX);
+			coordinates.push_back(originY + (offsetY+j) * dY);
+			coordinates.push_back(0);
+		}
+	encode(&coordinates[0], coordinates.size(), points);
 }
 
 void VtkWriter::writeTimeStep(
@@ -60,63 +92,175 @@ void VtkWriter::writeTimeStep(
         const Float2D &i_hv,
         float i_time)
 {
-	std::ofstream vtkFile(generateFileName().c_str());
+	// The bathymetry is encoded with the first time step
+	if (bathymetry.empty()) {
+		gatherInterior(b, &buffer[0]);
+		encode(&buffer[0], buffer.size(), bathymetry);
+	}
+
+	// Compute the selected fields and remember their offsets in the appended data section
+	data.clear();
+	std::vector<size_t> fieldOffsets(fields.size());
+	for (size_t i = 0; i < fields.size(); i++) {
+		fieldOffsets[i] = points.size() + data.size();
+		gatherField(fields[i], i_h, i_hu, i_hv, &buffer[0]);
+		encode(&buffer[0], buffer.size(), data);
+	}
+	const size_t bOffset = points.size() + data.size();
+
+	std::ofstream vtkFile(generateFileName().c_str(), std::ios::binary);
 	assert(vtkFile.good());
 
 	// VTK header
-	vtkFile << "<?xml version=\"1.0\"?>" << std::endl
-			<< "<VTKFile type=\"StructuredGrid\">" << std::endl
-			<< "<StructuredGrid WholeExtent=\"" << offsetX << " " << offsetX+nX
-				<< " " << offsetY << " " << offsetY+nY << " 0 0\">" << std::endl
-	        << "<Piece Extent=\"" << offsetX << " " << offsetX+nX
-	        	<< " " << offsetY << " " << offsetY+nY << " 0 0\">" << std::endl;
-
-	vtkFile << "<Points>" << std::endl
-			<< "<DataArray NumberOfComponents=\"3\" type=\"Float32\" format=\"ascii\">" << std::endl;
-
-	//Grid points
-	for (int j=0; j < nY+1; j++)
-	      for (int i=0; i < nX+1; i++)
-	    	  vtkFile << (offsetX+i)*dX << " " << (offsetY+j)*dY <<" 0" << std::endl;
-
-	vtkFile << "</DataArray>" << std::endl
-			<< "</Points>" << std::endl;
-
-	vtkFile << "<CellData>" << std::endl;
-
-	// Water surface height h
-	vtkFile << "<DataArray Name=\"h\" type=\"Float32\" format=\"ascii\">" << std::endl;
-	for (int j=1; j < nY+1; j++)
-		for (int i=1; i < nX+1; i++)
-			vtkFile << i_h[i][j] << std::endl;
-	vtkFile << "</DataArray>" << std::endl;
-
-	// Momentums
-	vtkFile << "<DataArray Name=\"hu\" type=\"Float32\" format=\"ascii\">" << std::endl;
-	for (int j=1; j < nY+1; j++)
-		for (int i=1; i < nX+1; i++)
-			vtkFile << i_hu[i][j] << std::endl;
-	vtkFile << "</DataArray>" << std::endl;
-
-	vtkFile << "<DataArray Name=\"hv\" type=\"Float32\" format=\"ascii\">" << std::endl;
-	for (int j=1; j < nY+1; j++)
-		for (int i=1; i<nX+1; i++)
-			vtkFile << i_hv[i][j] << std::endl;
-	vtkFile << "</DataArray>" << std::endl;
-
-	// Bathymetry
-	vtkFile << "<DataArray Name=\"b\" type=\"Float32\" format=\"ascii\">" << std::endl;
-	for (int j=1; j<nY+1; j++)
-		for (int i=1; i<nX+1; i++)
-			vtkFile << b[i][j] << std::endl;
-	vtkFile << "</DataArray>" << std::endl;
-
-	vtkFile << "</CellData>" << std::endl
-			<< "</Piece>" << std::endl;
-
-	vtkFile << "</StructuredGrid>" << std::endl
-			<< "</VTKFile>" << std::endl;
+	vtkFile << "<?xml version=\"1.0\"?>\n"
+			<< "<VTKFile type=\"StructuredGrid\" version=\"1.0\" byte_order=\"" << byteOrder()
+				<< "\" header_type=\"UInt64\"" << compressorAttribute << ">\n"
+			<< "<StructuredGrid WholeExtent=\"";
+	writeExtent(vtkFile, offsetX, offsetY, nX, nY);
+	vtkFile << "\">\n"
+			<< "<Piece Extent=\"";
+	writeExtent(vtkFile, offsetX, offsetY, nX, nY);
+	vtkFile << "\">\n";
+
+	vtkFile << "<Points>\n"
+			<< "<DataArray NumberOfComponents=\"3\" type=\"Float32\" format=\"appended\" offset=\"0\"/>\n"
+			<< "</Points>\n";
+
+	vtkFile << "<CellData>\n";
+	for (size_t i = 0; i < fields.size(); i++)
+		vtkFile << "<DataArray Name=\"" << getFieldName(fields[i])
+				<< "\" type=\"Float32\" format=\"appended\" offset=\"" << fieldOffsets[i] << "\"/>\n";
+	vtkFile << "<DataArray Name=\"b\" type=\"Float32\" format=\"appended\" offset=\"" << bOffset << "\"/>\n"
+			<< "</CellData>\n"
+			<< "</Piece>\n"
+			<< "</StructuredGrid>\n";
+
+	// Binary data, starts after the underscore
+	vtkFile << "<AppendedData encoding=\"raw\">\n_";
+	vtkFile.write(points.data(), points.size());
+	vtkFile.write(data.data(), data.size());
+	vtkFile.write(bathymetry.data(), bathymetry.size());
+	vtkFile << "\n</AppendedData>\n"
+			<< "</VTKFile>\n";
+
+	if (!containerBaseName.empty())
+		writeContainer();
 
 	// Increament time step
 	timeStep++;
 }
+
+/**
+ * Enables the ParaView-Container-Files (.pvts), which combine the files of all blocks
+ * of a time step. Only one writer (usually the one of the first rank) should write them.
+ *
+ * @param i_containerBaseName base name of the container files.
+ */
+void VtkWriter::setContainerBaseName(const std::string &i_containerBaseName)
+{
+	containerBaseName = i_containerBaseName;
+}
+
+/**
+ * Adds a block to the ParaView-Container-Files.
+ * The files of the block are expected in the same directory as the container files.
+ *
+ * @param i_baseName base name of the block's output files.
+ * @param i_offsetX x-offset of the block (in cells).
+ * @param i_offsetY y-offset of the block (in cells).
+ * @param i_nX number of cells of the block in x-direction.
+ * @param i_nY number of cells of the block in y-direction.
+ */
+void VtkWriter::addContainerPiece(const std::string &i_baseName,
+		int i_offsetX, int i_offsetY,
+		int i_nX, int i_nY)
+{
+	Piece piece;
+	size_t directory = i_baseName.rfind('/');
+	piece.baseName = (directory == std::string::npos) ? i_baseName : i_baseName.substr(directory+1);
+	piece.offsetX = i_offsetX;
+	piece.offsetY = i_offsetY;
+	piece.nX = i_nX;
+	piece.nY = i_nY;
+	pieces.push_back(piece);
+}
+
+/**
+ * Appends an array to the appended data section.
+ *
+ * Without compression, the array is preceded by its size in bytes.
+ * With compression, the array is compressed as a single block, preceded by
+ * the number of blocks, the uncompressed block size, the size of the last
+ * partial block (0 = no partial block) and the compressed block size.
+ *
+ * @param i_values the array.
+ * @param i_count number of values.
+ * @param o_data the encoded array is appended to this string.
+ */
+void VtkWriter::encode(const float *i_values, size_t i_count, std::string &o_data)
+{
+	const uint64_t size = i_count * sizeof(float);
+
+#ifdef VTK_ZLIB
+	uLongf compressedSize = compressBound(size);
+	std::vector<Bytef> compressed(compressedSize);
+	int status = compress2(&compressed[0], &compressedSize,
+			reinterpret_cast<const Bytef*>(i_values), size, Z_BEST_SPEED);
+	assert(status == Z_OK);
+
+	const uint64_t header[4] = {1, size, 0, compressedSize};
+	o_data.append(reinterpret_cast<const char*>(header), sizeof(header));
+	o_data.append(reinterpret_cast<const char*>(&compressed[0]), compressedSize);
+#else // VTK_ZLIB
+	o_data.append(reinterpret_cast<const char*>(&size), sizeof(size));
+	o_data.append(reinterpret_cast<const char*>(i_values), size);
+#endif // VTK_ZLIB
+}
+
+void VtkWriter::writeExtent(std::ostream &o_stream,
+		int i_offsetX, int i_offsetY,
+		int i_nX, int i_nY)
+{
+	o_stream << i_offsetX << ' ' << i_offsetX+i_nX << ' '
+			<< i_offsetY << ' ' << i_offsetY+i_nY << " 0 0";
+}
+
+/**
+ * Writes the ParaView-Container-File of the current time step.
+ */
+void VtkWriter::writeContainer()
+{
+	std::ofstream containerFile(generateContainerFileName(containerBaseName, timeStep).c_str());
+	assert(containerFile.good());
+
+	// The whole grid covers all blocks
+	int wholeNX = 0, wholeNY = 0;
+	for (std::vector<Piece>::const_iterator piece = pieces.begin(); piece != pieces.end(); piece++) {
+		wholeNX = std::max(wholeNX, piece->offsetX + piece->nX);
+		wholeNY = std::max(wholeNY, piece->offsetY + piece->nY);
+	}
+
+	containerFile << "<?xml version=\"1.0\"?>\n"
+			<< "<VTKFile type=\"PStructuredGrid\" version=\"1.0\" byte_order=\"" << byteOrder()
+				<< "\" header_type=\"UInt64\">\n"
+			<< "<PStructuredGrid WholeExtent=\"";
+	writeExtent(containerFile, 0, 0, wholeNX, wholeNY);
+	containerFile << "\" GhostLevel=\"0\">\n"
+			<< "<PPoints>\n"
+			<< "<PDataArray NumberOfComponents=\"3\" type=\"Float32\"/>\n"
+			<< "</PPoints>\n"
+			<< "<PCellData>\n";
+	for (size_t i = 0; i < fields.size(); i++)
+		containerFile << "<PDataArray Name=\"" << getFieldName(fields[i]) << "\" type=\"Float32\"/>\n";
+	containerFile << "<PDataArray Name=\"b\" type=\"Float32\"/>\n"
+			<< "</PCellData>\n";
+
+	for (std::vector<Piece>::const_iterator piece = pieces.begin(); piece != pieces.end(); piece++) {
+		containerFile << "<Piece Extent=\"";
+		writeExtent(containerFile, piece->offsetX, piece->offsetY, piece->nX, piece->nY);
+		containerFile << "\" Source=\"" << piece->baseName << '.' << timeStep << ".vts\"/>\n";
+	}
+
+	containerFile << "</PStructuredGrid>\n"
+			<< "</VTKFile>\n";
+}
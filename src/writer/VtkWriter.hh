@@ -27,14 +27,56 @@
 #define VTKWRITER_HH_
 
 #include <sstream>
+#include <string>
+#include <vector>
 #include "writer/Writer.hh"
 
+/**
+ * Writes one structured grid file (.vts) per time step.
+ *
+ * All arrays are stored as binary appended data (optionally zlib compressed,
+ * see VTK_ZLIB). The grid points and the bathymetry do not change during the
+ * simulation, they are encoded only once and reused for all time steps.
+ */
 class VtkWriter : public Writer {
 private:
+	/**
+	 * Block of a multiple SWE_Block run, referenced in the ParaView-Container-File
+	 */
+	struct Piece {
+		//! base name of the block output (without time step and extension)
+		std::string baseName;
+		//! first cell of the block in x- and y-direction
+		int offsetX, offsetY;
+		//! number of cells of the block
+		int nX, nY;
+	};
+
 	//! cell size
 	float dX, dY;
 
-	float offsetX, offsetY;
+	int offsetX, offsetY;
+
+	//! coordinates of the first grid point of the whole grid (relative to the domain)
+	float originX, originY;
+
+	//! interior of one grid, x is the fastest index
+	std::vector<float> buffer;
+
+	//! encoded grid points (static)
+	std::string points;
+
+	//! encoded bathymetry (static)
+	std::string bathymetry;
+
+	//! encoded unknowns of the current time step
+	std::string data;
+
+	//! base name of the ParaView-Container-Files, empty if no container is written
+	std::string containerBaseName;
+
+	//! all blocks listed in the ParaView-Container-Files
+	std::vector<Piece> pieces;
 
 public:
 	VtkWriter( const std::string &i_fileName,
@@ -42,7 +84,8 @@ public:
 			   const BoundarySize &i_boundarySize,
 			   int i_nX, int i_nY,
 			   float i_dX, float i_dY,
-			   int i_offsetX = 0, int i_offsetY = 0);
+			   int i_offsetX = 0, int i_offsetY = 0,
+			   float i_originX = 0, float i_originY = 0);
 
     // writes the unknowns at a given time step to a vtk file
     void writeTimeStep( const Float2D &i_h,
@@ -50,6 +93,25 @@ public:
                         const Float2D &i_hv,
                         float i_time);
 
+    // writes a ParaView-Container-File for each time step
+    void setContainerBaseName(const std::string &i_containerBaseName);
+
+    // adds a block to the ParaView-Container-Files
+    void addContainerPiece(const std::string &i_baseName,
+                           int i_offsetX, int i_offsetY,
+                           int i_nX, int i_nY);
+
+private:
+    // appends an array (header + data) to the appended data section
+    static void encode(const float *i_values, size_t i_count, std::string &o_data);
+
+    // writes the XML extent of a block
+    static void writeExtent(std::ostream &o_stream,
+                            int i_offsetX, int i_offsetY,
+                            int i_nX, int i_nY);
+
+    void writeContainer();
+
 private:
     std::string generateFileName()
     {
@@ -26,8 +26,16 @@
 #ifndef WRITER_HH_
 #define WRITER_HH_
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
 #include "tools/help.hh"
 #include "tools/Float2D.hh"
+#include "writer/OutputRegion.hh"
 
 /**
  * This struct is used so we can initialize this array
@@ -51,6 +59,19 @@ struct BoundarySize {
 
 class Writer {
 	public:
+		/**
+		 * Quantities which can be written
+		 */
+		enum Field {
+			WATER_HEIGHT,		//!< h
+			MOMENTUM_X,			//!< hu
+			MOMENTUM_Y,			//!< hv
+			SURFACE_ELEVATION,	//!< eta = h + b
+			SPEED,				//!< |u| = |(hu, hv)| / h
+			FROUDE_NUMBER,		//!< |u| / sqrt(g h)
+			FIELD_COUNT
+		};
+
 		/**
 		 * @param i_boundarySize size of the boundaries.
 		 */
@@ -62,10 +83,65 @@ class Writer {
 			b(i_b),
 			boundarySize(i_boundarySize),
 			nX(i_nX), nY(i_nY),
-			timeStep(0) {}
+			region(i_nX, i_nY),
+			timeStep(0)
+		{
+			fields.push_back(WATER_HEIGHT);
+			fields.push_back(MOMENTUM_X);
+			fields.push_back(MOMENTUM_Y);
+		}
 
 		virtual ~Writer() {}
 
+		/**
+		 * Writes only a part of the block, must be called before the first time step.
+		 * The writer has to be constructed with the size of the region (nX, nY)
+		 * and the corresponding cell size and origin.
+		 *
+		 * @param i_region cells of the block which are written.
+		 */
+		void setRegion(const OutputRegion &i_region) {
+			assert(i_region.getNX() == static_cast<int>(nX) && i_region.getNY() == static_cast<int>(nY));
+			region = i_region;
+		}
+
+		/**
+		 * Selects the quantities written in every time step (default: h, hu, hv),
+		 * must be called before the first time step. The bathymetry is always written once.
+		 */
+		void setFields(const std::vector<Field> &i_fields) {
+			assert(!i_fields.empty());
+			fields = i_fields;
+		}
+
+		/**
+		 * @return the name of a field in the output files
+		 */
+		static const char* getFieldName(Field i_field) {
+			static const char* const names[FIELD_COUNT] = {"h", "hu", "hv", "eta", "speed", "froude"};
+			return names[i_field];
+		}
+
+		/**
+		 * Parses a comma separated list of field names (e.g. "h,eta,speed").
+		 *
+		 * @return false if a name is unknown.
+		 */
+		static bool parseFields(const std::string &i_list, std::vector<Field> &o_fields) {
+			o_fields.clear();
+			std::istringstream list(i_list);
+			std::string name;
+			while (std::getline(list, name, ',')) {
+				int field = 0;
+				while (field < FIELD_COUNT && name != getFieldName(static_cast<Field>(field)))
+					field++;
+				if (field == FIELD_COUNT)
+					return false;
+				o_fields.push_back(static_cast<Field>(field));
+			}
+			return !o_fields.empty();
+		}
+
 		/**
 		 * Writes one time step
 		 *
@@ -81,6 +157,52 @@ class Writer {
 				float i_time) = 0;
 
 	protected:
+		/**
+		 * Copies the interior of a grid (without the boundary) into a contiguous buffer.
+		 *
+		 * @param i_matrix grid including the boundary.
+		 * @param o_buffer nY * nX values.
+		 */
+		void gatherInterior(const Float2D &i_matrix, float *o_buffer) const {
+			gatherField<WATER_HEIGHT>(i_matrix, i_matrix, i_matrix, o_buffer);
+		}
+
+		/**
+		 * Computes a field in the interior and copies it into a contiguous buffer.
+		 *
+		 * @param i_field the field.
+		 * @param i_h water heights (including the boundary).
+		 * @param i_hu momentums in x-direction (including the boundary).
+		 * @param i_hv momentums in y-direction (including the boundary).
+		 * @param o_buffer nY * nX values.
+		 */
+		void gatherField(Field i_field,
+				const Float2D &i_h, const Float2D &i_hu, const Float2D &i_hv,
+				float *o_buffer) const {
+			switch (i_field) {
+			case WATER_HEIGHT:
+				gatherField<WATER_HEIGHT>(i_h, i_hu, i_hv, o_buffer);
+				break;
+			case MOMENTUM_X:
+				gatherField<MOMENTUM_X>(i_h, i_hu, i_hv, o_buffer);
+				break;
+			case MOMENTUM_Y:
+				gatherField<MOMENTUM_Y>(i_h, i_hu, i_hv, o_buffer);
+				break;
+			case SURFACE_ELEVATION:
+				gatherField<SURFACE_ELEVATION>(i_h, i_hu, i_hv, o_buffer);
+				break;
+			case SPEED:
+				gatherField<SPEED>(i_h, i_hu, i_hv, o_buffer);
+				break;
+			case FROUDE_NUMBER:
+				gatherField<FROUDE_NUMBER>(i_h, i_hu, i_hv, o_buffer);
+				break;
+			default:
+				assert(false);
+			}
+		}
+
 		//! file name of the data file
 		const std::string fileName;
 
@@ -93,7 +215,82 @@ class Writer {
 		//! dimensions of the grid in x- and y-direction.
 		const unsigned int nX, nY;
 
+		//! cells of the block which are written
+		OutputRegion region;
+
+		//! quantities written in every time step
+		std::vector<Field> fields;
+
 		//! current time step
 		size_t timeStep;
+
+	private:
+		/**
+		 * @return the value of a field in a cell (the switch is resolved at compile time)
+		 */
+		template<Field F>
+		static float fieldValue(float i_h, float i_hu, float i_hv, float i_b) {
+			// Velocities are not defined in dry cells
+			const float dryTolerance = .01f;
+			const float gravity = 9.81f;
+
+			switch (F) {
+			case MOMENTUM_X:
+				return i_hu;
+			case MOMENTUM_Y:
+				return i_hv;
+			case SURFACE_ELEVATION:
+				return i_h + i_b;
+			case SPEED:
+				return (i_h > dryTolerance) ? std::sqrt(i_hu*i_hu + i_hv*i_hv) / i_h : 0.f;
+			case FROUDE_NUMBER:
+				return (i_h > dryTolerance) ? std::sqrt((i_hu*i_hu + i_hv*i_hv) / (gravity * i_h)) / i_h : 0.f;
+			default:
+				return i_h;
+			}
+		}
+
+		/**
+		 * Computes a field in the interior and copies it into a contiguous buffer.
+		 *
+		 * Float2D is stored column wise ([x][y], y is the fastest index),
+		 * the output formats expect x to be the fastest index, hence the data is transposed.
+		 * Derived fields are computed in the same pass, the inner loop runs over contiguous columns.
+		 * With output strides, each value is the average of the corresponding cells.
+		 */
+		template<Field F>
+		void gatherField(const Float2D &i_h, const Float2D &i_hu, const Float2D &i_hv,
+				float *o_buffer) const {
+			const int firstX = region.firstX + boundarySize[0];
+			const int firstY = region.firstY + boundarySize[2];
+
+			if (region.strideX == 1 && region.strideY == 1) {
+				for(unsigned int col = 0; col < nX; col++) {
+					const float *h = &i_h[firstX+col][firstY];
+					const float *hu = &i_hu[firstX+col][firstY];
+					const float *hv = &i_hv[firstX+col][firstY];
+					const float *bathymetry = &b[firstX+col][firstY];
+					for(unsigned int row = 0; row < nY; row++)
+						o_buffer[row*nX + col] = fieldValue<F>(h[row], hu[row], hv[row], bathymetry[row]);
+				}
+				return;
+			}
+
+			const int endX = region.endX + boundarySize[0];
+			const int endY = region.endY + boundarySize[2];
+			for(unsigned int col = 0; col < nX; col++) {
+				const int x0 = firstX + col*region.strideX;
+				const int x1 = std::min(x0 + region.strideX, endX);
+				for(unsigned int row = 0; row < nY; row++) {
+					const int y0 = firstY + row*region.strideY;
+					const int y1 = std::min(y0 + region.strideY, endY);
+					float sum = 0;
+					for(int x = x0; x < x1; x++)
+						for(int y = y0; y < y1; y++)
+							sum += fieldValue<F>(i_h[x][y], i_hu[x][y], i_hv[x][y], b[x][y]);
+					o_buffer[row*nX + col] = sum / ((x1-x0) * (y1-y0));
+				}
+			}
+		}
 };
 #endif // WRITER_HH_